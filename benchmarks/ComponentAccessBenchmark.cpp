@@ -0,0 +1,129 @@
+/**
+ * @file ComponentAccessBenchmark.cpp
+ * @brief Measures component reads from several threads at once.
+ *
+ * Compares, for 1, 2, 4, ... threads up to the maximum given as the first
+ * argument (defaults to the hardware threads):
+ * - Coordinator::HasComponent plus GetComponent;
+ * - TryGetData on the array cached from Coordinator::GetComponentArray;
+ * - the same reads through a std::shared_ptr copied per access, as the
+ *   component manager used to hand out its arrays. Every copy increments and
+ *   decrements one shared count, so this path stops scaling with the threads.
+ */
+#include <ecs/Coordinator.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t EntityCount = 4096;
+    constexpr std::size_t ReadsPerThread = 4000000;
+    constexpr int Repetitions = 5;
+
+    struct PositionComponent
+    {
+        float x, y;
+    };
+
+    /**
+     * @brief Runs a read loop on several threads at once, several times.
+     * @return The best throughput in million reads per second.
+     */
+    template<typename F>
+    double ReadThroughput(const std::size_t threads, F&& read)
+    {
+        double best = 0.0;
+        for (int i = 0; i < Repetitions; ++i)
+        {
+            std::vector<std::thread> readers;
+            readers.reserve(threads);
+
+            const auto start = std::chrono::steady_clock::now();
+            for (std::size_t t = 0; t < threads; ++t)
+            {
+                readers.emplace_back([&read, t]
+                {
+                    float sum = 0.0f;
+                    for (std::size_t j = 0; j < ReadsPerThread; ++j)
+                    {
+                        sum += read((j + t * 97) % EntityCount);
+                    }
+                    volatile float sink = sum;
+                    (void)sink;
+                });
+            }
+            for (std::thread& reader : readers)
+            {
+                reader.join();
+            }
+            const auto end = std::chrono::steady_clock::now();
+
+            const double seconds = std::chrono::duration<double>(end - start).count();
+            best = std::max(best, static_cast<double>(threads * ReadsPerThread) / seconds / 1e6);
+        }
+        return best;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t maxThreads = argc > 1 ? static_cast<std::size_t>(std::max(1, std::atoi(argv[1]))) : hardwareThreads;
+
+    ecs::Coordinator coordinator;
+    coordinator.Init(EntityCount, ecs::StorageMode::Sparse, 0);
+    coordinator.RegisterComponent<PositionComponent>();
+
+    std::vector<ecs::Entity> entities;
+    entities.reserve(EntityCount);
+    for (std::size_t i = 0; i < EntityCount; ++i)
+    {
+        const ecs::Entity entity = coordinator.CreateEntity();
+        coordinator.AddComponent<PositionComponent>(entity, {static_cast<float>(i), 1.0f});
+        entities.push_back(entity);
+    }
+
+    auto& positions = coordinator.GetComponentArray<PositionComponent>();
+
+    // Shares the count of a separate owner, as a copy of the old array handle did
+    const auto owner = std::make_shared<int>(0);
+    const std::shared_ptr<ecs::ComponentStorage<PositionComponent>> shared(owner, &positions);
+
+    std::printf("Component read benchmark, %zu hardware threads, %zu reads per thread, best of %d runs\n",
+                hardwareThreads, ReadsPerThread, Repetitions);
+    std::printf("threads  Has+GetComponent (M/s)  cached array (M/s)  shared_ptr per read (M/s)\n");
+
+    for (std::size_t threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        const double coordinatorReads = ReadThroughput(threads, [&](const std::size_t i)
+        {
+            const ecs::Entity entity = entities[i];
+            return coordinator.HasComponent<PositionComponent>(entity)
+                ? coordinator.GetComponent<PositionComponent>(entity).x
+                : 0.0f;
+        });
+
+        const double cachedReads = ReadThroughput(threads, [&](const std::size_t i)
+        {
+            const PositionComponent* position = positions.TryGetData(entities[i]);
+            return position ? position->x : 0.0f;
+        });
+
+        const double sharedReads = ReadThroughput(threads, [&](const std::size_t i)
+        {
+            const std::shared_ptr<ecs::ComponentStorage<PositionComponent>> array = shared;
+            const PositionComponent* position = array->TryGetData(entities[i]);
+            return position ? position->x : 0.0f;
+        });
+
+        std::printf("%7zu  %22.1f  %18.1f  %25.1f\n", threads, coordinatorReads, cachedReads, sharedReads);
+    }
+
+    return 0;
+}
@@ -0,0 +1,120 @@
+/**
+ * @file EventBusContentionBenchmark.cpp
+ * @brief Compares emitting events from worker threads through the per-thread
+ * buffers of the EventBus with pushing them to one queue behind a shared mutex.
+ *
+ * The mutex-guarded queue is handed to the bus on the main thread, as an EventBus
+ * without a job system only accepts events from the thread that processes them.
+ *
+ * Emits one million events from a ParallelFor and processes them, for 1, 2, 4, ...
+ * threads up to the maximum given as the first argument (defaults to 16).
+ */
+#include <ecs/EventBus.hpp>
+#include <ecs/JobSystem.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t EventCount = 1000000;
+    constexpr std::size_t Grain = 4096;
+    constexpr int Repetitions = 5;
+
+    struct BenchmarkEvent
+    {
+        std::uint32_t value;
+        std::uint32_t padding;
+    };
+
+    /**
+     * @brief Runs a function once to warm up and then several times.
+     * @return The average run in milliseconds.
+     */
+    template<typename F>
+    double Average(F&& function)
+    {
+        function();
+
+        double total = 0.0;
+        for (int i = 0; i < Repetitions; ++i)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            function();
+            const auto end = std::chrono::steady_clock::now();
+            total += std::chrono::duration<double, std::milli>(end - start).count();
+        }
+        return total / Repetitions;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t maxThreads = argc > 1 ? static_cast<std::size_t>(std::max(1, std::atoi(argv[1]))) : 16;
+
+    std::printf("EventBus contention benchmark, %u hardware threads, %zu events, average of %d runs\n",
+                std::thread::hardware_concurrency(), EventCount, Repetitions);
+    std::printf("threads  per-thread buffers (ms)  shared mutex queue (ms)\n");
+
+    for (std::size_t threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        ecs::JobSystem jobs(threads - 1);
+
+        std::uint64_t perThreadSum = 0;
+        ecs::EventBus perThreadBus;
+        perThreadBus.SetJobSystem(jobs);
+        perThreadBus.AddListener<BenchmarkEvent>([&](const BenchmarkEvent& event) { perThreadSum += event.value; });
+
+        std::uint64_t lockedSum = 0;
+        std::mutex mutex;
+        std::vector<BenchmarkEvent> lockedQueue;
+        ecs::EventBus lockedBus;
+        lockedBus.AddListener<BenchmarkEvent>([&](const BenchmarkEvent& event) { lockedSum += event.value; });
+
+        const double perThread = Average([&]
+        {
+            jobs.ParallelFor(0, EventCount, Grain, [&](const std::size_t begin, const std::size_t end)
+            {
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    perThreadBus.Emit(BenchmarkEvent {static_cast<std::uint32_t>(i), 0});
+                }
+            });
+            perThreadBus.ProcessEvents();
+        });
+
+        const double locked = Average([&]
+        {
+            jobs.ParallelFor(0, EventCount, Grain, [&](const std::size_t begin, const std::size_t end)
+            {
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    std::lock_guard lock(mutex);
+                    lockedQueue.push_back(BenchmarkEvent {static_cast<std::uint32_t>(i), 0});
+                }
+            });
+            for (const BenchmarkEvent& event : lockedQueue)
+            {
+                lockedBus.Emit(event);
+            }
+            lockedQueue.clear();
+            lockedBus.ProcessEvents();
+        });
+
+        if (perThreadSum != lockedSum)
+        {
+            std::fprintf(stderr, "The buses delivered different events\n");
+            return EXIT_FAILURE;
+        }
+
+        std::printf("%7zu  %23.2f  %23.2f\n", threads, perThread, locked);
+    }
+
+    return EXIT_SUCCESS;
+}
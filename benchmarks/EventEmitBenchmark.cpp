@@ -0,0 +1,173 @@
+/**
+ * @file EventEmitBenchmark.cpp
+ * @brief Measures queuing and dispatching one million collision events.
+ *
+ * Compares the EventBus channels, with a std::function listener and with a
+ * member function delegate, against AnyEventBus below: a copy of the former
+ * design that queued every event as a std::any beside its std::type_index and
+ * looked the listeners up in an unordered_map per event. Each bus is also run
+ * with a second event type emitted after every eighth collision, so that the
+ * queue holds mixed types.
+ */
+#include <ecs/EventBus.hpp>
+
+#include <any>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    constexpr int EventCount = 1000000;
+    constexpr int Repetitions = 3;
+
+    struct CollisionEvent
+    {
+        ecs::Entity entity1, entity2;
+    };
+
+    struct ScoreEvent
+    {
+        int points;
+    };
+
+    struct CollisionSink
+    {
+        std::uint64_t checksum = 0;
+
+        void OnCollision(const CollisionEvent& event)
+        {
+            checksum += event.entity1 ^ event.entity2;
+        }
+    };
+
+    /**
+     * @brief The former type-erased event bus, kept as the reference for the channels.
+     */
+    class AnyEventBus
+    {
+    public:
+        template<typename EventType>
+        void AddListener(std::function<void(const EventType&)> listener)
+        {
+            m_listeners[std::type_index(typeid(EventType))].push_back([fn = std::move(listener)](const std::any& event)
+            {
+                fn(std::any_cast<const EventType&>(event));
+            });
+        }
+
+        template<typename EventType>
+        void Emit(const EventType& event)
+        {
+            m_eventQueue.push_back({std::type_index(typeid(EventType)), event});
+        }
+
+        void ProcessEvents()
+        {
+            const auto currentQueue = std::move(m_eventQueue);
+            m_eventQueue.clear();
+
+            for (const auto& [type, event] : currentQueue)
+            {
+                // The listeners were copied per event, as the former bus did
+                const auto listeners = m_listeners.find(type)->second;
+                for (const auto& listener : listeners)
+                {
+                    listener(event);
+                }
+            }
+        }
+
+    private:
+        std::vector<std::pair<std::type_index, std::any>> m_eventQueue;
+        std::unordered_map<std::type_index, std::vector<std::function<void(const std::any&)>>> m_listeners;
+    };
+
+    struct Timing
+    {
+        double emit = 0.0;
+        double dispatch = 0.0;
+    };
+
+    double Milliseconds(const std::chrono::steady_clock::duration duration)
+    {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+
+    /**
+     * @brief Emits EventCount collisions and processes them, several times.
+     * @return The average emit and dispatch time in milliseconds.
+     */
+    template<typename Bus>
+    Timing Run(Bus& bus, const bool mixed)
+    {
+        Timing timing;
+        for (int i = 0; i < Repetitions; ++i)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            for (int j = 0; j < EventCount; ++j)
+            {
+                bus.Emit(CollisionEvent{static_cast<ecs::Entity>(j), static_cast<ecs::Entity>(j * 7)});
+                if (mixed && j % 8 == 0)
+                {
+                    bus.Emit(ScoreEvent{j});
+                }
+            }
+            const auto emitted = std::chrono::steady_clock::now();
+            bus.ProcessEvents();
+            const auto end = std::chrono::steady_clock::now();
+
+            timing.emit += Milliseconds(emitted - start) / Repetitions;
+            timing.dispatch += Milliseconds(end - emitted) / Repetitions;
+        }
+        return timing;
+    }
+
+    void Print(const char* name, const Timing timing)
+    {
+        std::printf("%-40s  %10.2f  %12.2f  %10.2f\n", name, timing.emit, timing.dispatch, timing.emit + timing.dispatch);
+    }
+}
+
+int main()
+{
+    CollisionSink anySink, functionSink, delegateSink;
+
+    AnyEventBus anyBus;
+    anyBus.AddListener<CollisionEvent>([&anySink](const CollisionEvent& event) { anySink.OnCollision(event); });
+    anyBus.AddListener<ScoreEvent>([](const ScoreEvent&) { });
+
+    ecs::EventBus functionBus;
+    functionBus.AddListener<CollisionEvent>([&functionSink](const CollisionEvent& event) { functionSink.OnCollision(event); });
+    functionBus.AddListener<ScoreEvent>([](const ScoreEvent&) { });
+
+    ecs::EventBus delegateBus;
+    delegateBus.AddListener<&CollisionSink::OnCollision>(delegateSink);
+    delegateBus.AddListener<ScoreEvent>([](const ScoreEvent&) { });
+
+    std::printf("Event emit benchmark, %d CollisionEvent per frame, average of %d\n", EventCount, Repetitions);
+    std::printf("%-40s  %10s  %12s  %10s\n", "bus", "emit ms", "dispatch ms", "total ms");
+    for (const bool mixed : {false, true})
+    {
+        const char* suffix = mixed ? ", mixed" : "";
+        char name[64];
+        std::snprintf(name, sizeof(name), "std::any queue, std::function%s", suffix);
+        Print(name, Run(anyBus, mixed));
+        std::snprintf(name, sizeof(name), "channels, std::function%s", suffix);
+        Print(name, Run(functionBus, mixed));
+        std::snprintf(name, sizeof(name), "channels, member delegate%s", suffix);
+        Print(name, Run(delegateBus, mixed));
+    }
+
+    if (anySink.checksum != functionSink.checksum || functionSink.checksum != delegateSink.checksum)
+    {
+        std::puts("The buses delivered different events");
+        return 1;
+    }
+    return 0;
+}
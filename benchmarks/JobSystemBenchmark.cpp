@@ -0,0 +1,128 @@
+/**
+ * @file JobSystemBenchmark.cpp
+ * @brief Measures how the JobSystem scales with the number of threads.
+ *
+ * Runs three workloads for 1, 2, 4, ... threads up to the maximum given as the
+ * first argument (defaults to the hardware threads):
+ * - empty jobs: the cost of scheduling and waiting for a job;
+ * - fine-grained jobs: a ParallelFor with a small grain;
+ * - a Movement-like pass: position += velocity * dt over a large array.
+ */
+#include <ecs/JobSystem.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t EmptyJobCount = 100000;
+    constexpr std::size_t ElementCount = 1 << 20;
+    constexpr std::size_t FineGrain = 64;
+    constexpr std::size_t MovementGrain = 4096;
+    constexpr int Repetitions = 7;
+    constexpr float DeltaTime = 0.016f;
+
+    struct Transform
+    {
+        float x, y, rotation;
+    };
+
+    struct Velocity
+    {
+        float x, y;
+    };
+
+    /**
+     * @brief Runs a function several times.
+     * @return The fastest run in microseconds.
+     */
+    template<typename F>
+    double Best(F&& function)
+    {
+        double best = 1e30;
+        for (int i = 0; i < Repetitions; ++i)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            function();
+            const auto end = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::micro>(end - start).count());
+        }
+        return best;
+    }
+
+    void Move(std::vector<Transform>& transforms, const std::vector<Velocity>& velocities,
+              const std::size_t begin, const std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            transforms[i].x += velocities[i].x * DeltaTime;
+            transforms[i].y += velocities[i].y * DeltaTime;
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t maxThreads = argc > 1 ? std::max(1, std::atoi(argv[1])) : hardwareThreads;
+
+    std::vector<Transform> transforms(ElementCount, {1.0f, 2.0f, 0.0f});
+    const std::vector<Velocity> velocities(ElementCount, {0.5f, 0.25f});
+
+    // Warm up the caches and the clock before the serial baseline
+    Move(transforms, velocities, 0, ElementCount);
+    const double serialMovement = Best([&] { Move(transforms, velocities, 0, ElementCount); });
+
+    std::printf("JobSystem benchmark, %zu hardware threads, best of %d runs\n", hardwareThreads, Repetitions);
+    std::printf("movement serial: %.0f us\n\n", serialMovement);
+    std::printf("threads  empty (ns/job)  fine-grained (us)  movement (us)  movement speedup\n");
+
+    for (std::size_t threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        ecs::JobSystem jobs(threads - 1);
+
+        std::vector<ecs::JobHandle> handles;
+        handles.reserve(EmptyJobCount);
+        const double empty = Best([&]
+        {
+            handles.clear();
+            for (std::size_t i = 0; i < EmptyJobCount; ++i)
+            {
+                handles.push_back(jobs.Schedule([] {}));
+            }
+            jobs.Wait(handles);
+        });
+
+        volatile float sink = 0.0f;
+        const double fine = Best([&]
+        {
+            jobs.ParallelFor(0, ElementCount, FineGrain, [&](const std::size_t begin, const std::size_t end)
+            {
+                float sum = 0.0f;
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    sum += std::sqrt(static_cast<float>(i));
+                }
+                sink = sink + sum;
+            });
+        });
+
+        const double movement = Best([&]
+        {
+            jobs.ParallelFor(0, ElementCount, MovementGrain, [&](const std::size_t begin, const std::size_t end)
+            {
+                Move(transforms, velocities, begin, end);
+            });
+        });
+
+        std::printf("%7zu  %14.0f  %17.0f  %13.0f  %15.2fx\n",
+                    threads, empty * 1000.0 / EmptyJobCount, fine, movement, serialMovement / movement);
+    }
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+/**
+ * @file SignatureChurnBenchmark.cpp
+ * @brief Measures AddComponent and RemoveComponent against the number of
+ * registered systems.
+ *
+ * Registers 32 component types and 10, 50 or 200 systems, each requiring one
+ * to three random components. 10000 entities then have two components added
+ * and removed again, and the best time per call is reported. Every call
+ * changes the entity signature, so this is the cost of matching one changed
+ * signature against the systems.
+ */
+#include <ecs/Coordinator.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    constexpr int ComponentCount = 32;
+    constexpr int EntityCount = 10000;
+    constexpr int Repetitions = 5;
+
+    template<int I>
+    struct Component
+    {
+        int value;
+    };
+
+    template<int I>
+    struct ChurnSystem : ecs::System { };
+
+    template<int... I>
+    void RegisterComponents(ecs::Coordinator& coordinator, std::integer_sequence<int, I...>)
+    {
+        (coordinator.RegisterComponent<Component<I>>(), ...);
+    }
+
+    template<int... I>
+    void RegisterSystems(ecs::Coordinator& coordinator, std::mt19937& random, std::integer_sequence<int, I...>)
+    {
+        ([&]
+        {
+            coordinator.RegisterSystem<ChurnSystem<I>>();
+
+            ecs::Signature signature;
+            const int required = 1 + static_cast<int>(random() % 3);
+            for (int j = 0; j < required; ++j)
+            {
+                signature.set(random() % ComponentCount);
+            }
+            coordinator.SetSystemSignature<ChurnSystem<I>>(signature);
+        }(), ...);
+    }
+
+    /**
+     * @brief Toggles two components on every entity with SystemCount systems registered.
+     * @return The best time per AddComponent or RemoveComponent call in nanoseconds.
+     */
+    template<int SystemCount>
+    double Churn()
+    {
+        std::mt19937 random(42);
+        ecs::Coordinator coordinator;
+        coordinator.Init(2 * EntityCount);
+        RegisterComponents(coordinator, std::make_integer_sequence<int, ComponentCount>{});
+        RegisterSystems(coordinator, random, std::make_integer_sequence<int, SystemCount>{});
+
+        std::vector<ecs::Entity> entities;
+        entities.reserve(EntityCount);
+        for (int i = 0; i < EntityCount; ++i)
+        {
+            entities.push_back(coordinator.CreateEntityWith(Component<0>{}, Component<1>{}, Component<2>{},
+                                                            Component<3>{}, Component<4>{}));
+        }
+
+        double best = 1e30;
+        for (int i = 0; i < Repetitions; ++i)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            for (const ecs::Entity entity : entities)
+            {
+                coordinator.AddComponent(entity, Component<10>{});
+                coordinator.AddComponent(entity, Component<20>{});
+            }
+            for (const ecs::Entity entity : entities)
+            {
+                coordinator.RemoveComponent<Component<10>>(entity);
+                coordinator.RemoveComponent<Component<20>>(entity);
+            }
+            const auto end = std::chrono::steady_clock::now();
+
+            best = std::min(best, std::chrono::duration<double, std::nano>(end - start).count() / (4.0 * EntityCount));
+        }
+        return best;
+    }
+}
+
+int main()
+{
+    std::printf("Signature churn benchmark, %d entities, %d component types\n", EntityCount, ComponentCount);
+    std::printf("%8s  %12s\n", "systems", "ns/call");
+    std::printf("%8d  %12.1f\n", 10, Churn<10>());
+    std::printf("%8d  %12.1f\n", 50, Churn<50>());
+    std::printf("%8d  %12.1f\n", 200, Churn<200>());
+
+    return 0;
+}
@@ -0,0 +1,131 @@
+/**
+ * @file SoABenchmark.cpp
+ * @brief Compares the per-entity cost of the SoA column kernels with the same
+ * work on array-of-structs components.
+ *
+ * Each frame integrates positions, clamps them to the screen and decrements
+ * lifespans for 100000 entities, once through a Group of AoS components and
+ * once through the columns of SoA components with the kernels of
+ * SimdKernels.hpp. Configure with SIMPLYECS_ENABLE_AVX2 to measure the AVX2
+ * kernels instead of SSE2.
+ */
+#include <ecs/Coordinator.hpp>
+#include <ecs/SimdKernels.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <type_traits>
+
+namespace
+{
+    constexpr int EntityCount = 100000;
+    constexpr int FrameCount = 200;
+    constexpr float DeltaTime = 1.0f / 60.0f;
+    constexpr float Width = 800.0f;
+    constexpr float Height = 600.0f;
+
+    struct Vec2
+    {
+        float x, y;
+    };
+
+    // The same components twice: stored as structs, and opted into SoA storage below
+    struct TransformAoS { Vec2 position; float rotation, scale, angle; };
+    struct VelocityAoS  { Vec2 velocity; float speed; };
+    struct LifespanAoS  { float total, remaining; };
+
+    struct TransformSoA { Vec2 position; float rotation, scale, angle; };
+    struct VelocitySoA  { Vec2 velocity; float speed; };
+    struct LifespanSoA  { float total, remaining; };
+
+    double NanosecondsPerEntity(const std::chrono::steady_clock::duration duration)
+    {
+        return std::chrono::duration<double, std::nano>(duration).count() / (static_cast<double>(EntityCount) * FrameCount);
+    }
+}
+
+template<> struct ecs::SoALayout<TransformSoA> : std::true_type { };
+template<> struct ecs::SoALayout<VelocitySoA> : std::true_type { };
+template<> struct ecs::SoALayout<LifespanSoA> : std::true_type { };
+
+int main()
+{
+    ecs::Coordinator coordinator;
+    coordinator.Init(2 * EntityCount);
+    coordinator.RegisterComponent<TransformAoS>();
+    coordinator.RegisterComponent<VelocityAoS>();
+    coordinator.RegisterComponent<LifespanAoS>();
+    coordinator.RegisterComponent<TransformSoA>();
+    coordinator.RegisterComponent<VelocitySoA>();
+    coordinator.RegisterComponent<LifespanSoA>();
+
+    for (int i = 0; i < EntityCount; ++i)
+    {
+        const Vec2 position {static_cast<float>(i % 800), static_cast<float>(i % 600)};
+        const Vec2 velocity {1.0f + static_cast<float>(i % 7), -2.0f + static_cast<float>(i % 5)};
+
+        const ecs::Entity aos = coordinator.CreateEntity();
+        coordinator.AddComponent<TransformAoS>(aos, {position, 0.0f, 1.0f, 0.0f});
+        coordinator.AddComponent<VelocityAoS>(aos, {velocity, 3.0f});
+        coordinator.AddComponent<LifespanAoS>(aos, {1e6f, 1e6f});
+
+        const ecs::Entity soa = coordinator.CreateEntity();
+        coordinator.AddComponent<TransformSoA>(soa, {position, 0.0f, 1.0f, 0.0f});
+        coordinator.AddComponent<VelocitySoA>(soa, {velocity, 3.0f});
+        coordinator.AddComponent<LifespanSoA>(soa, {1e6f, 1e6f});
+    }
+
+    volatile std::size_t sink = 0;
+
+    auto movement = coordinator.Group<TransformAoS, VelocityAoS>();
+    auto& lifespansAoS = coordinator.GetComponentArray<LifespanAoS>();
+    const auto aosStart = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < FrameCount; ++frame)
+    {
+        movement.Each([](ecs::Entity, TransformAoS& transform, const VelocityAoS& velocity)
+        {
+            transform.position.x = std::clamp(transform.position.x + velocity.velocity.x * DeltaTime, 0.0f, Width);
+            transform.position.y = std::clamp(transform.position.y + velocity.velocity.y * DeltaTime, 0.0f, Height);
+        });
+
+        std::size_t expired = 0;
+        for (std::size_t i = 0; i < lifespansAoS.Size(); ++i)
+        {
+            LifespanAoS& lifespan = lifespansAoS.GetDataAt(i);
+            lifespan.remaining -= DeltaTime;
+            expired += lifespan.remaining <= 0.0f;
+        }
+        sink = sink + expired;
+    }
+    const auto aosEnd = std::chrono::steady_clock::now();
+
+    // The SoA components were added together, so the rows of their columns belong to the same entities
+    auto& transforms = coordinator.GetComponentArray<TransformSoA>();
+    auto& velocities = coordinator.GetComponentArray<VelocitySoA>();
+    auto& lifespansSoA = coordinator.GetComponentArray<LifespanSoA>();
+    const std::size_t x = ecs::SoALane(offsetof(TransformSoA, position));
+    const std::size_t vx = ecs::SoALane(offsetof(VelocitySoA, velocity));
+    const std::size_t remaining = ecs::SoALane(offsetof(LifespanSoA, remaining));
+
+    const auto soaStart = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < FrameCount; ++frame)
+    {
+        const std::size_t count = transforms.Size();
+        ecs::Simd::IntegratePositions(transforms.GetColumn(x), velocities.GetColumn(vx), DeltaTime, count);
+        ecs::Simd::IntegratePositions(transforms.GetColumn(x + 1), velocities.GetColumn(vx + 1), DeltaTime, count);
+        ecs::Simd::ClampToBounds(transforms.GetColumn(x), 0.0f, Width, count);
+        ecs::Simd::ClampToBounds(transforms.GetColumn(x + 1), 0.0f, Height, count);
+        sink = sink + ecs::Simd::DecrementLifespans(lifespansSoA.GetColumn(remaining), DeltaTime, lifespansSoA.Size());
+    }
+    const auto soaEnd = std::chrono::steady_clock::now();
+
+    const double aos = NanosecondsPerEntity(aosEnd - aosStart);
+    const double soa = NanosecondsPerEntity(soaEnd - soaStart);
+    std::printf("SoA benchmark, %d entities, %d frames of integrate, clamp and lifespan\n", EntityCount, FrameCount);
+    std::printf("%s kernels: AoS %.3f ns/entity, SoA %.3f ns/entity (%.2fx)\n",
+                ecs::Simd::GetInstructionSet(), aos, soa, aos / soa);
+
+    return 0;
+}
@@ -0,0 +1,129 @@
+/**
+ * @file ViewBenchmark.cpp
+ * @brief Compares Coordinator::View with iterating a system's entities and
+ * looking up each component through Coordinator::GetComponent.
+ *
+ * A Movement-like update (transform += velocity * dt) runs over 200000
+ * entities, once with every entity holding both components and once with
+ * only one in ten holding a velocity, where the view iterates the smaller pool.
+ */
+#include <ecs/Coordinator.hpp>
+#include <ecs/System.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <initializer_list>
+
+namespace
+{
+    constexpr int EntityCount = 200000;
+    constexpr int Repetitions = 50;
+    constexpr float DeltaTime = 0.016f;
+
+    struct Transform
+    {
+        float x, y, rotation, angularVelocity;
+    };
+
+    struct Velocity
+    {
+        float x, y;
+    };
+
+    // The pattern views replace: every component looked up through the Coordinator
+    class MovementSystem final : public ecs::System
+    {
+    public:
+        explicit MovementSystem(ecs::Coordinator& coordinator) : m_coordinator(coordinator) {}
+
+        void Update(const float dt) override
+        {
+            for (const auto [entity, _] : m_entities)
+            {
+                auto& transform = m_coordinator.GetComponent<Transform>(entity);
+                const auto& velocity = m_coordinator.GetComponent<Velocity>(entity);
+                transform.x += velocity.x * dt;
+                transform.y += velocity.y * dt;
+                transform.rotation += transform.angularVelocity * dt;
+            }
+        }
+
+    private:
+        ecs::Coordinator& m_coordinator;
+    };
+
+    /**
+     * @brief Runs a function once to warm up and then several times.
+     * @return The average run in milliseconds.
+     */
+    template<typename F>
+    double Average(F&& function)
+    {
+        function();
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < Repetitions; ++i)
+        {
+            function();
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        return std::chrono::duration<double, std::milli>(end - start).count() / Repetitions;
+    }
+}
+
+int main()
+{
+    std::printf("View benchmark, %d entities, average of %d runs (ms)\n", EntityCount, Repetitions);
+    std::printf("with velocity  m_entities+GetComponent  View::Each  View range-for\n");
+
+    for (const int velocityEvery : {1, 10})
+    {
+        ecs::Coordinator coordinator;
+        coordinator.Init(EntityCount);
+        coordinator.RegisterComponent<Transform>();
+        coordinator.RegisterComponent<Velocity>();
+
+        const auto system = coordinator.RegisterSystem<MovementSystem>(coordinator);
+        ecs::Signature signature;
+        signature.set(coordinator.GetComponentTypeID<Transform>());
+        signature.set(coordinator.GetComponentTypeID<Velocity>());
+        coordinator.SetSystemSignature<MovementSystem>(signature);
+
+        for (int i = 0; i < EntityCount; ++i)
+        {
+            const ecs::Entity entity = coordinator.CreateEntity();
+            coordinator.AddComponent<Transform>(entity, {1.0f, 2.0f, 3.0f, 4.0f});
+            if (i % velocityEvery == 0)
+            {
+                coordinator.AddComponent<Velocity>(entity, {1.0f, 1.0f});
+            }
+        }
+
+        const double lookups = Average([&] { system->Update(DeltaTime); });
+
+        const double each = Average([&]
+        {
+            coordinator.View<Transform, Velocity>().Each([](ecs::Entity, Transform& transform, const Velocity& velocity)
+            {
+                transform.x += velocity.x * DeltaTime;
+                transform.y += velocity.y * DeltaTime;
+                transform.rotation += transform.angularVelocity * DeltaTime;
+            });
+        });
+
+        const double rangeFor = Average([&]
+        {
+            for (auto [entity, transform, velocity] : coordinator.View<Transform, Velocity>())
+            {
+                transform.x += velocity.x * DeltaTime;
+                transform.y += velocity.y * DeltaTime;
+                transform.rotation += transform.angularVelocity * DeltaTime;
+            }
+        });
+
+        std::printf("       1 in %2d  %23.3f  %10.3f  %14.3f\n", velocityEvery, lookups, each, rangeFor);
+    }
+
+    return 0;
+}
@@ -0,0 +1,337 @@
+/**
+ * @file ArchetypeStorage.hpp
+ * @brief Archetype based component storage.
+ *
+ * Entities with the same signature live together in an archetype. An archetype
+ * stores its entities in fixed-size chunks, each holding one packed column per
+ * component type, so entities that are processed together are also stored
+ * together. Adding or removing a component moves the entity's row to the
+ * archetype of its new signature.
+ *
+ * This is an alternative to the per-type ComponentArray storage, selected with
+ * StorageMode::Archetype in Coordinator::Init.
+ */
+#ifndef ARCHETYPESTORAGE_HPP
+#define ARCHETYPESTORAGE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Debug.hpp"
+#include "PagedArray.hpp"
+#include "Types.hpp"
+
+namespace ecs {
+
+    /**
+     * @brief Type-erased operations needed to keep a component type in a column.
+     */
+    struct ComponentInfo
+    {
+        std::size_t size      = 0; // sizeof the component, 0 for tags, which get no column
+        std::size_t alignment = 0; // alignof the component, 0 while the type is not registered
+
+        // Move-constructs a component at destination from source, then destroys source
+        void (*relocate)(void* destination, void* source) = nullptr;
+
+        // Destroys a component in place
+        void (*destroy)(void* component) = nullptr;
+
+        /**
+         * @brief Builds the info for a component type.
+         * @tparam T The component type.
+         */
+        template<typename T>
+        static ComponentInfo Of();
+    };
+
+    /**
+     * @brief Storage for all entities that share one signature.
+     *
+     * Rows are packed: row r lives in chunk r / GetChunkCapacity(). Removing a
+     * row moves the last row into its place.
+     */
+    class Archetype
+    {
+    public:
+        static constexpr std::size_t ChunkSize      = 16 * 1024; // Bytes per chunk
+        static constexpr std::size_t ChunkAlignment = 64;        // Alignment of every chunk
+
+        /**
+         * @brief Creates an empty archetype.
+         * @param signature The components every entity in this archetype has.
+         * @param infos Component infos indexed by component type ID.
+         */
+        Archetype(Signature signature, const std::vector<ComponentInfo>& infos);
+
+        ~Archetype();
+
+        Archetype(const Archetype&) = delete;
+        Archetype& operator=(const Archetype&) = delete;
+
+        /**
+         * @brief Gets the signature shared by the entities of this archetype.
+         */
+        Signature GetSignature() const { return m_signature; }
+
+        /**
+         * @brief Gets the number of entities in this archetype.
+         */
+        std::size_t Size() const { return m_size; }
+
+        /**
+         * @brief Gets the number of rows a chunk holds.
+         */
+        std::size_t GetChunkCapacity() const { return m_chunkCapacity; }
+
+        /**
+         * @brief Gets the number of chunks in use.
+         */
+        std::size_t GetChunkCount() const { return (m_size + m_chunkCapacity - 1) / m_chunkCapacity; }
+
+        /**
+         * @brief Gets the number of rows used in a chunk.
+         * @param chunk Index of a chunk in use.
+         */
+        std::size_t GetChunkSize(std::size_t chunk) const;
+
+        /**
+         * @brief Gets the entity column of a chunk.
+         * @param chunk Index of a chunk in use.
+         * @return Pointer to GetChunkSize(chunk) entities.
+         */
+        const Entity* GetEntities(std::size_t chunk) const;
+
+        /**
+         * @brief Gets a component column of a chunk.
+         * @tparam T The component type stored under the given ID.
+         * @param chunk Index of a chunk in use.
+         * @param type The component type ID.
+         * @return Pointer to GetChunkSize(chunk) components.
+         */
+        template<typename T>
+        T* GetColumn(std::size_t chunk, ComponentTypeID type);
+
+        /**
+         * @brief Gets the entity stored in a row.
+         */
+        Entity GetEntity(std::size_t row) const;
+
+        /**
+         * @brief Gets the address of a component in a row.
+         * @param row The row.
+         * @param type A component type in this archetype's signature.
+         * @return Address of the component.
+         */
+        void* GetComponent(std::size_t row, ComponentTypeID type);
+
+        /**
+         * @brief Appends a row for an entity, allocating a chunk if needed.
+         *
+         * The components of the new row are left unconstructed; the caller must
+         * construct every column before the row is read.
+         *
+         * @param entity The entity owning the row.
+         * @return The new row.
+         */
+        std::size_t PushRow(Entity entity);
+
+        /**
+         * @brief Removes a row whose components have already been destroyed or moved out.
+         *
+         * The last row is relocated into the freed row to keep rows packed.
+         *
+         * @param row The row to remove.
+         * @return The entity now stored at row, or NullEntity if the last row was removed.
+         */
+        Entity RemoveRow(std::size_t row);
+
+        /**
+         * @brief Destroys every component of a row.
+         * @param row The row.
+         */
+        void DestroyRow(std::size_t row);
+
+        /**
+         * @brief Destroys every row. Chunks and edges are kept for reuse.
+         */
+        void Clear();
+
+        /**
+         * @brief Gets the cached neighbour archetype reached by adding or removing a component.
+         * @param type The component type.
+         * @param add True for the add edge, false for the remove edge.
+         * @return Reference to the cached pointer; nullptr until it is resolved.
+         */
+        Archetype*& Edge(ComponentTypeID type, bool add);
+
+    private:
+        // Marks component types that have no column in this archetype
+        static constexpr std::size_t NoColumn = static_cast<std::size_t>(-1);
+
+        struct alignas(ChunkAlignment) Chunk
+        {
+            std::byte data[ChunkSize];
+        };
+
+        struct Column
+        {
+            ComponentTypeID type;   // Component type stored in the column
+            std::size_t     offset; // Byte offset of the column inside a chunk
+            ComponentInfo   info;   // How to move and destroy its components
+        };
+
+        // Gets the address of a row inside a column
+        std::byte* Address(std::size_t row, std::size_t offset, std::size_t size) const;
+
+        Signature                                m_signature;     // Components of every entity in this archetype
+        std::vector<Column>                      m_columns;       // One column per non-tag component, by ascending type ID
+        std::array<std::size_t, MaxComponents>   m_columnIndices; // Index into m_columns per component type ID, or NoColumn
+        std::size_t                              m_chunkCapacity; // Rows per chunk
+        std::size_t                              m_size;          // Rows in use
+        std::vector<std::unique_ptr<Chunk>>      m_chunks;        // Allocated chunks, kept when emptied
+        std::array<Archetype*, MaxComponents>    m_addEdges;      // Archetype reached by adding a component
+        std::array<Archetype*, MaxComponents>    m_removeEdges;   // Archetype reached by removing a component
+    };
+
+    /**
+     * @brief Owns every archetype and tracks which row each entity is stored in.
+     *
+     * Component types are identified by the IDs handed out by ComponentManager,
+     * so signatures mean the same thing for both storages.
+     */
+    class ArchetypeStorage
+    {
+    public:
+        ArchetypeStorage();
+
+        /**
+         * @brief Registers a component type under an already assigned type ID.
+         * @tparam T The component type.
+         * @param type The component type ID.
+         */
+        template<typename T>
+        void RegisterComponentType(ComponentTypeID type);
+
+        /**
+         * @brief Adds a component, moving the entity to the archetype of its new signature.
+         * @tparam T The component type.
+         * @param entity The entity.
+         * @param type The component type ID of T.
+         * @param component The component to copy in.
+         */
+        template<typename T>
+        void AddComponent(Entity entity, ComponentTypeID type, const T& component);
+
+        /**
+         * @brief Moves an entity directly to the archetype of its final signature.
+         *
+         * Used to apply several component changes at once without moving the
+         * entity through the intermediate archetypes. Components in both the old
+         * and the new signature are carried over and the ones left out are
+         * destroyed. Components the entity gains are left unconstructed; each one
+         * must be constructed with ConstructComponent before it is read.
+         *
+         * @param entity The entity.
+         * @param signature The components the entity will have.
+         */
+        void PlaceEntity(Entity entity, Signature signature);
+
+        /**
+         * @brief Constructs a component an entity gained through PlaceEntity.
+         * @tparam T The component type.
+         * @param entity The entity.
+         * @param type The component type ID of T.
+         * @param component The component to copy in.
+         */
+        template<typename T>
+        void ConstructComponent(Entity entity, ComponentTypeID type, const T& component);
+
+        /**
+         * @brief Removes a component, moving the entity to the archetype of its new signature.
+         * @param entity The entity.
+         * @param type The component type ID.
+         */
+        void RemoveComponent(Entity entity, ComponentTypeID type);
+
+        /**
+         * @brief Gets a component of an entity.
+         *
+         * The reference is invalidated by any structural change to an entity of
+         * the same archetype, since rows are moved to stay packed.
+         *
+         * @tparam T The component type.
+         * @param entity The entity.
+         * @param type The component type ID of T.
+         * @return Reference to the component.
+         */
+        template<typename T>
+        T& GetComponent(Entity entity, ComponentTypeID type);
+
+        /**
+         * @brief Checks if an entity has a component.
+         * @param entity The entity.
+         * @param type The component type ID.
+         * @return True if the entity has the component, false otherwise.
+         */
+        bool HasComponent(Entity entity, ComponentTypeID type) const;
+
+        /**
+         * @brief Destroys every component of an entity.
+         * @param entity The entity being destroyed.
+         */
+        void EntityDestroyed(Entity entity);
+
+        /**
+         * @brief Destroys the components of every entity.
+         *
+         * Archetypes are emptied in place, keeping their chunks and cached edges.
+         */
+        void Clear();
+
+        /**
+         * @brief Collects the archetypes whose signature contains a given signature.
+         * @param signature The components an archetype must have.
+         * @param archetypes Receives the matching archetypes.
+         */
+        void GetMatchingArchetypes(Signature signature, std::vector<Archetype*>& archetypes) const;
+
+    private:
+        // Where an entity's components are stored
+        struct Location
+        {
+            Archetype*    archetype = nullptr; // nullptr while the entity has no components
+            std::uint32_t row       = 0;       // Row inside the archetype
+        };
+
+        // Gets the archetype for a signature, creating it on first use; nullptr for the empty signature
+        Archetype* GetOrCreateArchetype(Signature signature);
+
+        // Gets the archetype reached by adding or removing one component, caching the edge
+        Archetype* GetNeighbour(Archetype* archetype, ComponentTypeID type, bool add);
+
+        // Moves an entity's row to another archetype, leaving the new column (if any) unconstructed
+        std::size_t MoveEntity(Entity entity, Location& location, Archetype* target);
+
+        // Removes a row and fixes the location of the entity moved into it
+        void RemoveRow(Archetype& archetype, std::size_t row);
+
+        // Locations per page (one page covers 1024 entity slots)
+        static constexpr std::size_t LocationPageSize = 1024;
+
+        std::vector<ComponentInfo>                     m_componentInfos; // Column operations per component type ID
+        std::vector<std::unique_ptr<Archetype>>        m_archetypes;     // Every archetype created so far
+        std::unordered_map<Signature, Archetype*>      m_bySignature;    // Archetype lookup by signature
+        PagedArray<Location, LocationPageSize>         m_locations;      // Location per entity slot
+    };
+
+} // namespace ecs
+
+#include "../src/ArchetypeStorage.tpp"
+
+#endif //ARCHETYPESTORAGE_HPP
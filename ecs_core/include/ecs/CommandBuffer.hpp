@@ -0,0 +1,179 @@
+/**
+ * @file CommandBuffer.hpp
+ * @brief Deferred recording of structural changes.
+ *
+ * Adding or removing components and creating or destroying entities while a
+ * system iterates its entities would change the very sets being iterated. A
+ * CommandBuffer records these operations instead, and Coordinator::PlaybackCommands
+ * applies the commands of every buffer at a sync point: sorted by entity, with
+ * all commands for one entity folded into a single storage change and a single
+ * signature update.
+ *
+ * The template members depend on the Coordinator and are defined by including
+ * Coordinator.hpp.
+ */
+#ifndef COMMANDBUFFER_HPP
+#define COMMANDBUFFER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Debug.hpp"
+#include "SystemStats.hpp"
+#include "Types.hpp"
+
+namespace ecs {
+
+    class Coordinator;
+
+    /**
+     * @brief Records entity and component operations for later playback.
+     *
+     * Buffers are obtained from Coordinator::GetCommandBuffer, one per thread, so
+     * recording needs no locking. Commands for the same entity are applied in
+     * the order they were recorded; when an entity is given the same component
+     * type several times, the last value wins, and adding a component the entity
+     * already has assigns the new value.
+     */
+    class CommandBuffer
+    {
+    public:
+        /**
+         * @brief Handle to an entity the buffer will create.
+         *
+         * Only meaningful to the buffer that returned it, and only until playback.
+         */
+        struct PendingEntity
+        {
+            std::uint32_t id; // Index of the entity among the buffer's creations
+        };
+
+        /**
+         * @brief Creates an empty buffer.
+         * @param coordinator The coordinator the commands will be played back on.
+         */
+        explicit CommandBuffer(Coordinator& coordinator);
+
+        ~CommandBuffer();
+
+        CommandBuffer(const CommandBuffer&) = delete;
+        CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+        /**
+         * @brief Records the creation of an entity.
+         * @return Handle for adding components to the entity before it exists.
+         */
+        PendingEntity CreateEntity();
+
+        /**
+         * @brief Records the destruction of an entity. Later commands for it are dropped.
+         * @param entity The entity to destroy.
+         */
+        void DestroyEntity(Entity entity);
+
+        /**
+         * @brief Records adding a component to an entity.
+         * @tparam T A registered component type.
+         * @param entity The entity. Commands for entities that are gone by playback are dropped.
+         * @param component The component to copy in.
+         */
+        template<typename T>
+        void AddComponent(Entity entity, const T& component);
+
+        /**
+         * @brief Records adding a component to an entity created by this buffer.
+         * @tparam T A registered component type.
+         * @param entity The pending entity.
+         * @param component The component to copy in.
+         */
+        template<typename T>
+        void AddComponent(PendingEntity entity, const T& component);
+
+        /**
+         * @brief Records removing a component from an entity.
+         *
+         * Removing a component the entity does not have by playback is a no-op.
+         *
+         * @tparam T A registered component type.
+         * @param entity The entity.
+         */
+        template<typename T>
+        void RemoveComponent(Entity entity);
+
+        /**
+         * @brief Gets the number of recorded commands.
+         */
+        std::size_t Size() const { return m_commands.size(); }
+
+        /**
+         * @brief Checks if no commands are recorded.
+         */
+        bool IsEmpty() const { return m_commands.empty(); }
+
+        /**
+         * @brief Drops every recorded command.
+         */
+        void Clear();
+
+    private:
+        friend class Coordinator;
+
+        enum class CommandKind : std::uint8_t
+        {
+            Create,
+            Destroy,
+            Add,
+            Remove
+        };
+
+        struct Command
+        {
+            Entity          entity;  // Target entity, or the pending ID if pending is set
+            ComponentTypeID type;    // Component type of Add and Remove commands
+            std::uint32_t   payload; // Index of the value in the type's payloads, for Add
+            CommandKind     kind;    // What to do
+            bool            pending; // Whether entity refers to an entity created by this buffer
+        };
+
+        // Type-erased list of recorded component values
+        class IPayloads
+        {
+        public:
+            virtual ~IPayloads() = default;
+            virtual const void* Get(std::uint32_t index) const = 0;
+            virtual void Clear() = 0;
+        };
+
+        template<typename T>
+        class Payloads final : public IPayloads
+        {
+        public:
+            const void* Get(const std::uint32_t index) const override { return &values[index]; }
+            void Clear() override { values.clear(); }
+
+            std::vector<T> values; // Values in recording order
+        };
+
+        // Stores a component value, constructing it or assigning it if the entity already has one
+        using SetFunction = void (*)(Coordinator& coordinator, Entity entity, const void* component, bool exists);
+
+        struct PayloadPool
+        {
+            std::unique_ptr<IPayloads> values; // Recorded values of one component type
+            SetFunction                set;    // Writes one of them to an entity
+        };
+
+        // Records an Add command for an entity or a pending entity
+        template<typename T>
+        void RecordAdd(Entity entity, bool pending, const T& component);
+
+        Coordinator&             m_coordinator;  // Coordinator the buffer belongs to
+        std::vector<Command>     m_commands;     // Commands in recording order
+        std::vector<PayloadPool> m_payloads;     // Component values per component type ID
+        std::uint32_t            m_pendingCount; // Entities created so far
+    };
+
+} // namespace ecs
+
+#endif //COMMANDBUFFER_HPP
@@ -4,16 +4,23 @@
  *
  * The ComponentManager provides a type-safe interface for adding, removing, and
  * accessing components attached to entities. It maintains a separate array for
- * each component type.
+ * each component type, either a ComponentArray or, for types that opt in
+ * through SoALayout, an SoAComponentArray. Tag types (see IsTag) get an ID but
+ * no array; the Coordinator tracks them in signatures only.
  */
 #ifndef COMPONENTMANAGER_HPP
 #define COMPONENTMANAGER_HPP
 
+#include <array>
+#include <limits>
 #include <memory>
-#include <string>
-#include <unordered_map>
+#include <span>
+#include <type_traits>
+#include <vector>
 #include "Types.hpp"
 #include "DenseMap.hpp"
+#include "SoALayout.hpp"
+#include "TypeIndex.hpp"
 #include "Debug.hpp"
 
 namespace ecs
@@ -36,11 +43,93 @@ namespace ecs
          */
         virtual bool HasData(Entity entity) = 0;
 
+        /**
+         * @brief Removes the component of an entity that has one.
+         * @param entity The entity to remove the component from.
+         */
+        virtual void RemoveData(Entity entity) = 0;
+
         /**
          * @brief Handles entity destruction by removing components.
-         * @param entity The entity being destroyed.
+         * @param entities Entities being destroyed, each of which has this component.
+         */
+        virtual void EntitiesDestroyed(std::span<const Entity> entities) = 0;
+
+        /**
+         * @brief Removes every component, keeping the storage for reuse.
+         */
+        virtual void Clear() = 0;
+
+        /**
+         * @brief Gets the position of an entity's component in the packed storage.
+         * @param entity An entity that has this component.
+         * @return Index of the component.
+         */
+        virtual std::size_t IndexOf(Entity entity) = 0;
+
+        /**
+         * @brief Swaps an entity's component with the one stored at a position.
+         * @param entity An entity that has this component.
+         * @param index The position to move the component to.
+         */
+        virtual void MoveToIndex(Entity entity, std::size_t index) = 0;
+    };
+
+    /**
+     * @brief Bookkeeping of an owning group.
+     *
+     * The entities that have every owned component occupy positions [0, Size())
+     * of each owned array, in the same order, so the group can be walked as
+     * zipped arrays without lookups. Owned arrays call OnInsert after adding a
+     * component and OnRemove before removing one to keep it that way.
+     */
+    class GroupStorage
+    {
+    public:
+        /**
+         * @brief Creates an empty group.
+         * @param owned The component types owned by the group.
+         */
+        explicit GroupStorage(Signature owned);
+
+        /**
+         * @brief Adds an array to the owned arrays. Call before any entity enters the group.
+         * @param array Storage of one of the owned component types.
+         */
+        void Own(IComponentArray& array);
+
+        /**
+         * @brief Moves an entity into the group if it has every owned component.
+         * @param entity An entity that just received an owned component.
+         */
+        void OnInsert(Entity entity);
+
+        /**
+         * @brief Moves an entity out of the group if it is a member.
+         * @param entity An entity about to lose an owned component.
+         * @param source The owned array the component is removed from.
+         */
+        void OnRemove(Entity entity, IComponentArray& source);
+
+        /**
+         * @brief Gets the number of entities in the group.
          */
-        virtual void EntityDestroyed(Entity entity) = 0;
+        std::size_t Size() const { return m_size; }
+
+        /**
+         * @brief Gets the component types owned by the group.
+         */
+        Signature GetOwned() const { return m_owned; }
+
+        /**
+         * @brief Empties the group. Call when every owned array is cleared.
+         */
+        void Clear() { m_size = 0; }
+
+    private:
+        Signature                     m_owned;  // Owned component types
+        std::vector<IComponentArray*> m_arrays; // Storage of each owned type
+        std::size_t                   m_size;   // Number of members, packed at the front of every owned array
     };
 
     /**
@@ -48,7 +137,7 @@ namespace ecs
      * @tparam T The component type this array stores.
      */
     template<typename T>
-    class ComponentArray : public IComponentArray
+    class ComponentArray final : public IComponentArray
     {
     public:
         /**
@@ -62,7 +151,7 @@ namespace ecs
          * @brief Removes a component from an entity.
          * @param entity The entity to remove the component from.
          */
-        void RemoveData(Entity entity);
+        void RemoveData(Entity entity) override;
 
         /**
          * @brief Gets a component for an entity.
@@ -78,16 +167,162 @@ namespace ecs
          */
         bool HasData(Entity entity) override;
 
+        /**
+         * @brief Gets a component for an entity if it has one.
+         * @param entity The entity to get the component for.
+         * @return Pointer to the component, or nullptr if the entity does not have it.
+         */
+        T* TryGetData(Entity entity);
+
+        /**
+         * @brief Gets the component at a position in the packed storage.
+         * @param index Position in the range [0, Size()), matching GetEntities().
+         * @return Reference to the component.
+         */
+        T& GetDataAt(std::size_t index);
+
+        /**
+         * @brief Gets the entities that have this component, in storage order.
+         * @return Const reference to the packed entity list.
+         */
+        const std::vector<Entity>& GetEntities() const;
+
+        /**
+         * @brief Gets the number of stored components.
+         * @return The number of entities that have this component.
+         */
+        std::size_t Size() const;
+
         /**
          * @brief Handles entity destruction.
-         * @param entity The entity being destroyed.
+         * @param entities Entities being destroyed, each of which has this component.
          */
-        void EntityDestroyed(Entity entity) override;
+        void EntitiesDestroyed(std::span<const Entity> entities) override;
+
+        void Clear() override;
+
+        std::size_t IndexOf(Entity entity) override;
+
+        void MoveToIndex(Entity entity, std::size_t index) override;
+
+        /**
+         * @brief Sets the group that owns this array.
+         * @param group The owning group, or nullptr.
+         */
+        void SetGroup(GroupStorage* group);
+
+        /**
+         * @brief Gets the group that owns this array.
+         * @return The owning group, or nullptr if the array is not owned.
+         */
+        GroupStorage* GetGroup() const;
 
     private:
-        DenseMap<Entity, T> m_components; // Stores entity-component mappings
+        EntityMap<T>        m_components; // Stores entity-component mappings
+        GroupStorage*       m_group = nullptr; // Group keeping this array ordered, if any
     };
 
+    /**
+     * @brief Structure-of-arrays storage for components that opt in through SoALayout.
+     *
+     * Each float lane of the component is kept in its own packed column, in the
+     * same entity order as GetEntities(), so kernels can process a field of every
+     * entity with plain vector loads. Components are copied in and out by value;
+     * there is no T object to reference.
+     *
+     * @tparam T A trivially copyable component made only of floats.
+     */
+    template<typename T>
+    class SoAComponentArray final : public IComponentArray
+    {
+        static_assert(std::is_trivially_copyable_v<T> && std::is_standard_layout_v<T>,
+            "SoA components must be trivially copyable standard layout types");
+        static_assert(sizeof(T) % sizeof(float) == 0 && alignof(T) == alignof(float),
+            "SoA components must consist of float fields only");
+
+    public:
+        static constexpr std::size_t LaneCount = SoALaneCount<T>;
+
+        /**
+         * @brief Adds a component for an entity.
+         * @param entity The entity to associate the component with.
+         * @param component The component to scatter into the columns.
+         */
+        void InsertData(Entity entity, const T& component);
+
+        /**
+         * @brief Removes a component from an entity.
+         * @param entity The entity to remove the component from.
+         */
+        void RemoveData(Entity entity) override;
+
+        /**
+         * @brief Gathers a component of an entity from the columns.
+         * @param entity The entity to get the component for.
+         * @return Copy of the component.
+         */
+        T GetData(Entity entity) const;
+
+        /**
+         * @brief Scatters a new value of an entity's component into the columns.
+         * @param entity The entity that has the component.
+         * @param component The new value.
+         */
+        void SetData(Entity entity, const T& component);
+
+        /**
+         * @brief Checks if an entity has this component.
+         * @param entity The entity to check.
+         * @return True if the entity has the component, false otherwise.
+         */
+        bool HasData(Entity entity) override;
+
+        /**
+         * @brief Gets a column.
+         *
+         * The pointer is invalidated when components are added or removed.
+         *
+         * @param lane The lane, see SoALane.
+         * @return Pointer to Size() floats, in the order of GetEntities().
+         */
+        float* GetColumn(std::size_t lane);
+
+        /**
+         * @brief Gets the entities that have this component, in column order.
+         * @return Const reference to the packed entity list.
+         */
+        const std::vector<Entity>& GetEntities() const;
+
+        /**
+         * @brief Gets the number of stored components.
+         * @return The number of entities that have this component.
+         */
+        std::size_t Size() const;
+
+        /**
+         * @brief Handles entity destruction.
+         * @param entities Entities being destroyed, each of which has this component.
+         */
+        void EntitiesDestroyed(std::span<const Entity> entities) override;
+
+        void Clear() override;
+
+        std::size_t IndexOf(Entity entity) override;
+
+        void MoveToIndex(Entity entity, std::size_t index) override;
+
+    private:
+        EntitySparseIndex                               m_index;    // Maps entities to their position in the columns
+        std::vector<Entity>                             m_entities; // Entity of each position
+        std::array<std::vector<float>, LaneCount>       m_columns;  // One packed column per float lane
+    };
+
+    /**
+     * @brief Storage class used for a component type in StorageMode::Sparse.
+     */
+    template<typename T>
+    using ComponentStorage = std::conditional_t<IsSoA<T>, SoAComponentArray<T>, ComponentArray<T>>;
+
     /**
      * @brief Manages all component arrays and component type registration.
      */
@@ -99,10 +334,24 @@ namespace ecs
         ~ComponentManager() = default;
 
         /**
-         * @brief Handles entity destruction across all component arrays.
-         * @param entity The entity being destroyed.
+         * @brief Removes the components of destroyed entities that share a signature.
+         *
+         * Only the arrays of the component types in the signature are visited,
+         * each once for the whole batch.
+         *
+         * @param entities The entities being destroyed.
+         * @param signature The signature every one of them had.
+         */
+        void EntitiesDestroyed(std::span<const Entity> entities, Signature signature);
+
+        /**
+         * @brief Removes every component of every entity.
+         *
+         * Arrays and groups are emptied in place, so the cost is a reset of the
+         * occupied slots rather than a removal per component, and capacity is
+         * kept for reuse.
          */
-        void EntityDestroyed(Entity entity);
+        void Clear();
 
         /**
          * @brief Registers a new component type.
@@ -136,9 +385,17 @@ namespace ecs
         template<typename T>
         void RemoveComponent(Entity entity);
 
+        /**
+         * @brief Removes a component from an entity by type ID.
+         * @param entity The entity to remove the component from.
+         * @param type The ID of a registered component type the entity has. Does
+         *             nothing for tags.
+         */
+        void RemoveComponent(Entity entity, ComponentTypeID type);
+
         /**
          * @brief Gets a component from an entity.
-         * @tparam T The component type to get.
+         * @tparam T The component type to get. Must not be an SoA component.
          * @param entity The entity to get the component from.
          * @return Reference to the component.
          */
@@ -154,18 +411,46 @@ namespace ecs
         template<typename T>
         bool HasComponent(Entity entity);
 
+        /**
+         * @brief Gets the component array for a specific component type.
+         *
+         * The array is owned by the manager and stays at the same address for the
+         * manager's lifetime, so the reference can be cached.
+         *
+         * @tparam T The component type. Must not be a tag.
+         * @return Reference to the component array; an SoAComponentArray for SoA components.
+         */
+        template<typename T>
+        ComponentStorage<T>& GetComponentArray();
+
+        /**
+         * @brief Gets the group owning the given component types, creating it on first use.
+         *
+         * A component type can be owned by one group only. Creating a group sorts
+         * the entities that already have every owned component to the front of
+         * each owned array.
+         *
+         * @tparam Ts The owned component types.
+         * @return The group bookkeeping.
+         */
+        template<typename... Ts>
+        GroupStorage& GetOrCreateGroup();
+
     private:
         /**
-         * @brief Gets a component array for a specific component type.
+         * @brief Checks if a component type has been registered with this manager.
          * @tparam T The component type.
-         * @return Shared pointer to the component array.
+         * @return True if registered, false otherwise.
          */
         template<typename T>
-        std::shared_ptr<ComponentArray<T> > GetComponentArray();
+        bool IsRegistered() const;
+
+        // Marks process-wide type indices that are not registered with this manager
+        static constexpr ComponentTypeID UnregisteredID = std::numeric_limits<ComponentTypeID>::max();
 
-        std::unordered_map<std::string, ComponentTypeID> m_componentTypes; // Maps from type name to type ID
-        std::unordered_map<std::string, std::shared_ptr<IComponentArray> > m_componentArrays;
-        // Maps from type name to component array
+        std::vector<ComponentTypeID> m_componentTypes; // Maps from process-wide type index to type ID
+        std::vector<std::unique_ptr<IComponentArray> > m_componentArrays; // Component arrays indexed by type ID, null for tags
+        std::vector<std::unique_ptr<GroupStorage> > m_groups; // Owning groups created so far
         ComponentTypeID m_nextComponentTypeID; // Next available component type ID
     };
 } // namespace ecs
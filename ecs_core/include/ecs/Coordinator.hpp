@@ -8,12 +8,22 @@
 #ifndef COORDINATOR_HPP
 #define COORDINATOR_HPP
 
+#include <chrono>
 #include <memory>
+#include <span>
 #include <vector>
 #include "Types.hpp"
+#include "ArchetypeStorage.hpp"
+#include "CommandBuffer.hpp"
 #include "EntityManager.hpp"
+#include "JobSystem.hpp"
+#include "PerThread.hpp"
 #include "ComponentManager.hpp"
 #include "SystemManager.hpp"
+#include "SystemStats.hpp"
+#include "Group.hpp"
+#include "Prefab.hpp"
+#include "View.hpp"
 #include "Debug.hpp"
 
 namespace ecs {
@@ -24,15 +34,89 @@ namespace ecs {
         /**
          * @brief Initializes all managers.
          * Must be called before using any other methods.
+         * @param maxEntities Maximum number of entities alive at the same time.
+         *                    Storage grows on demand up to this limit.
+         * @param storage How components are stored. The component, entity and view
+         *                API works the same with either; GetComponentArray is only
+         *                available with StorageMode::Sparse.
+         * @param workerCount Number of worker threads of the job system. Defaults to
+         *                    one less than the hardware threads; zero runs every job
+         *                    on the thread that waits for it.
          */
-        void Init();
+        void Init(std::size_t maxEntities = MaxEntities, StorageMode storage = StorageMode::Sparse,
+                  std::size_t workerCount = JobSystem::GetDefaultWorkerCount());
+
+        /**
+         * @brief Gets the storage mode selected in Init.
+         * @return The storage mode.
+         */
+        StorageMode GetStorageMode() const;
+
+        /**
+         * @brief Gets the job system created in Init.
+         *
+         * It is the thread pool for all parallel work on this Coordinator's data:
+         * the Scheduler runs systems on it and systems can split their own loops
+         * with ParallelFor.
+         *
+         * @return The job system.
+         */
+        JobSystem& GetJobSystem();
 
         /**
          * @brief Creates a new entity.
-         * @return The newly created entity ID.
+         * @return The newly created entity ID, or NullEntity if the capacity given
+         *         to Init is exhausted.
          */
         Entity CreateEntity();
 
+        /**
+         * @brief Creates a new entity with a set of components.
+         *
+         * Equivalent to CreateEntity followed by one AddComponent per component,
+         * except that the signature is assigned once and systems are matched
+         * against the final signature only.
+         * @code
+         * coordinator.CreateEntityWith(TransformComponent{position}, VelocityComponent{velocity});
+         * @endcode
+         *
+         * @tparam Ts The component types, each at most once.
+         * @param components The components to add.
+         * @return The new entity, or NullEntity if the capacity given to Init is exhausted.
+         */
+        template<typename... Ts>
+        Entity CreateEntityWith(const Ts&... components);
+
+        /**
+         * @brief Bundles component values into a prefab for Instantiate.
+         * @tparam Ts The component types, each registered and at most once.
+         * @param components The values new instances start with.
+         * @return The prefab.
+         */
+        template<typename... Ts>
+        Prefab CreatePrefab(const Ts&... components);
+
+        /**
+         * @brief Creates an entity from a prefab.
+         * @param prefab The prefab to copy components from.
+         * @return The new entity, or NullEntity if the capacity given to Init is exhausted.
+         */
+        Entity Instantiate(const Prefab& prefab);
+
+        /**
+         * @brief Creates a batch of entities from a prefab.
+         *
+         * Components are copied in one type at a time and system membership is
+         * computed once for the whole batch.
+         *
+         * @param prefab The prefab to copy components from.
+         * @param count The number of entities to create.
+         * @param entities Receives the new entities, appended in creation order.
+         * @return The number of entities created, less than count only if the
+         *         capacity given to Init is exhausted.
+         */
+        std::size_t Instantiate(const Prefab& prefab, std::size_t count, std::vector<Entity>& entities);
+
         /**
          * @brief Marks an entity for destruction.
          * Actual destruction happens on DestroyQueuedEntities call.
@@ -48,6 +132,10 @@ namespace ecs {
 
         /**
          * @brief Checks if an entity is currently active.
+         *
+         * Safe to call with any handle, including NullEntity and handles kept
+         * after the entity was destroyed and its slot reused.
+         *
          * @param entity The entity to check.
          * @return True if the entity is alive, false otherwise.
          */
@@ -67,9 +155,49 @@ namespace ecs {
 
         /**
          * @brief Destroys all currently active entities.
+         *
+         * Every component store, system entity set and signature is emptied in
+         * one pass instead of destroying entities one by one, and capacity is
+         * kept for the next entities. Queued destructions and unplayed commands
+         * are dropped. Handles to the destroyed entities stay invalid.
          */
         void DestroyAllEntities();
 
+        /**
+         * @brief Gets the command buffer of the calling thread's JobSystem thread index.
+         *
+         * Systems record structural changes into it while they iterate their
+         * entities; the changes take effect on the next PlaybackCommands call.
+         * Each worker has its own buffer, so recording needs no lock; all
+         * non-worker threads share the buffer of index 0, so only one of them
+         * may record at a time. Fetch the buffer once per loop or chunk, or let
+         * System::ParallelEach pass it.
+         * @code
+         * CommandBuffer& commands = m_coordinator.GetCommandBuffer();
+         * for (const Entity entity : m_entities)
+         * {
+         *     commands.RemoveComponent<HealthChangeComponent>(entity);
+         * }
+         * @endcode
+         *
+         * @return The buffer. It lives as long as the Coordinator.
+         */
+        CommandBuffer& GetCommandBuffer();
+
+        /**
+         * @brief Applies the commands recorded in every command buffer, then processes queued destructions.
+         *
+         * Buffers are played back in JobSystem thread index order, the buffer of
+         * non-worker threads first, so the IDs given to recorded creations and
+         * the order of commands from different threads for the same entity only
+         * depend on which thread recorded what. Each buffer's entity creations
+         * are applied first; the remaining commands are sorted by entity,
+         * so each entity is moved in storage and matched against systems once no
+         * matter how many commands target it. Must not be called while a system
+         * iterates its entities or while another thread records commands.
+         */
+        void PlaybackCommands();
+
         /**
          * @brief Registers a component type with the ECS system.
          * @tparam T The component type to register.
@@ -96,6 +224,12 @@ namespace ecs {
 
         /**
          * @brief Gets a component from an entity.
+         *
+         * With StorageMode::Archetype the reference is invalidated when a component
+         * is added to or removed from any entity that shares the entity's archetype.
+         * SoA components (see SoALayout) cannot be referenced and are accessed
+         * through GetComponentArray instead. Tags (see IsTag) have no data.
+         *
          * @tparam T The component type to get.
          * @param entity The entity to get the component from.
          * @return Reference to the component.
@@ -115,11 +249,72 @@ namespace ecs {
          * @brief Checks if an entity has a component.
          * @tparam T The component type to check for.
          * @param entity The entity to check.
-         * @return True if the entity has the component, false otherwise.
+         * For tags this is a single signature test.
+         *
+         * @return True if the entity has the component, false otherwise or if the
+         *         handle refers to a destroyed entity.
          */
         template<typename T>
         bool HasComponent(Entity entity);
 
+        /**
+         * @brief Gets the storage for a component type.
+         *
+         * The array lives as long as the Coordinator, so systems can look it up once
+         * at construction and read or write components through it directly. Adding
+         * and removing components must still go through the Coordinator so that
+         * signatures and systems stay in sync. Only available with StorageMode::Sparse.
+         *
+         * For SoA components this is an SoAComponentArray, whose float columns can
+         * be handed to the kernels in SimdKernels.hpp:
+         * @code
+         * auto& lifespans = coordinator.GetComponentArray<LifespanComponent>();
+         * float* remaining = lifespans.GetColumn(ecs::SoALane(offsetof(LifespanComponent, remaining)));
+         * ecs::Simd::DecrementLifespans(remaining, dt, lifespans.Size());
+         * @endcode
+         *
+         * @tparam T The component type. Tags have no array.
+         * @return Reference to the component array.
+         */
+        template<typename T>
+        ComponentStorage<T>& GetComponentArray();
+
+        /**
+         * @brief Creates a view over every entity that has all of the given components.
+         *
+         * Iteration is driven by the smallest of the component arrays, or walks the
+         * chunks of every matching archetype with StorageMode::Archetype. Components
+         * are handed out by reference:
+         * @code
+         * coordinator.View<Transform, Velocity>().Each([](Entity e, Transform& t, Velocity& v) { ... });
+         * for (auto [e, t, v] : coordinator.View<Transform, Velocity>()) { ... }
+         * @endcode
+         *
+         * Tags among Ts only filter: they are checked against the entity's
+         * signature (or select archetypes) and are not handed out, so
+         * View<Transform, EnemyTag> visits (Entity, Transform&).
+         *
+         * @tparam Ts The component types an entity must have, at least one of them not a tag.
+         * @return The view.
+         */
+        template<typename... Ts>
+        ViewOf<Ts...> View();
+
+        /**
+         * @brief Gets the owning group of the given component types, creating it on first use.
+         *
+         * The group keeps the entities that have all of Ts at the front of each of
+         * their component arrays, in the same order, so iterating it needs no
+         * lookups. Adding and removing owned components costs a few extra swaps.
+         * A component type can be owned by one group only, and groups are only
+         * available with StorageMode::Sparse.
+         *
+         * @tparam Ts The component types owned by the group.
+         * @return Handle to the group.
+         */
+        template<typename... Ts>
+        ecs::Group<Ts...> Group();
+
         /**
          * @brief Registers a system with the ECS framework.
          * @tparam T The system type to register.
@@ -146,14 +341,118 @@ namespace ecs {
         template<typename T>
         std::shared_ptr<T> GetSystem() const;
 
+        /**
+         * @brief Starts timing every system update run through System::UpdateIfDue.
+         *
+         * Each system then keeps its last window updates, so the statistics
+         * follow recent frames. Structural changes and events made on the
+         * updating thread (and in ParallelEach chunks) are counted against the
+         * system. Disabled by default; while disabled the only cost is a
+         * pointer check per update and per counted operation.
+         *
+         * @param window Number of latest updates each system's statistics cover.
+         */
+        void EnableSystemStats(std::size_t window = 120);
+
+        /**
+         * @brief Stops timing system updates and drops the statistics.
+         */
+        void DisableSystemStats();
+
+        /**
+         * @brief Gets the statistics of every registered system.
+         *
+         * Must not be called while systems update.
+         *
+         * @return The statistics in registration order; empty while statistics are disabled.
+         */
+        std::vector<SystemStats> GetSystemStats() const;
+
+        /**
+         * @brief Sets the update time of a system above which the overrun callback is called.
+         *
+         * Only checked while statistics are enabled.
+         *
+         * @tparam T The system type.
+         * @param budget The budget; zero for none.
+         */
+        template<typename T>
+        void SetSystemBudget(std::chrono::nanoseconds budget);
+
+        /**
+         * @brief Sets the function called when a system's update exceeds its budget.
+         *
+         * The callback runs on the thread that updated the system. Must not be
+         * called while systems update.
+         *
+         * @param callback The callback; empty for none.
+         */
+        void SetBudgetOverrunCallback(BudgetOverrunCallback callback);
+
     private:
+        friend class CommandBuffer;
+
+        // A recorded command resolved to a live entity, for sorting across buffers
+        struct PlaybackCommand
+        {
+            Entity                        entity;  // The entity the command applies to
+            const CommandBuffer::Command* command; // The command
+            const CommandBuffer*          buffer;  // The buffer holding the command's payload
+        };
+
+        // Applies the sorted commands of one entity with a single storage change and signature update
+        void PlaybackEntityCommands(std::span<const PlaybackCommand> commands);
+
+        // Creates the view over data components Ts that also requires the given tags
+        template<typename... Ts>
+        ecs::View<Ts...> MakeView(Signature tags, ecs::View<Ts...>*);
+
+        // Destroyed entities that had the same signature
+        struct DestroyGroup
+        {
+            Signature           signature; // Signature the entities had
+            std::vector<Entity> entities;  // The entities, already released by the EntityManager
+        };
+
+        // Releases the components of destroyed entities that shared a signature from whichever storage is in use
+        void ComponentsDestroyed(std::span<const Entity> entities, Signature signature);
+
+        // Reserves storage for new entities that will receive exactly the components in signature
+        void PlaceEntities(std::span<const Entity> entities, Signature signature);
+
+        // Assigns the signature of new entities whose components are all in place and adds them to systems
+        void PublishEntities(std::span<const Entity> entities, Signature signature);
+
+        // Creates the components of a prefab for entities prepared with PlaceEntities
+        void InstantiateComponents(const Prefab& prefab, std::span<const Entity> entities);
+
+        // Copies a component into the storage of new entities without touching signatures
+        template<typename T>
+        void InsertComponents(std::span<const Entity> entities, const T& component);
+
+        // Builds the prefab entry holding a copy of a component
+        template<typename T>
+        static Prefab::Entry MakePrefabEntry(const T& component);
+
+        // Writes a recorded component value to an entity, assigning it if the entity already has one
+        template<typename T>
+        static void SetStoredComponent(Coordinator& coordinator, Entity entity, const void* component, bool exists);
+
         std::unique_ptr<EntityManager>    m_entityManager;     // Manages entity lifecycle
-        std::unique_ptr<ComponentManager> m_componentManager;  // Manages component storage
+        std::unique_ptr<ComponentManager> m_componentManager;  // Manages component type IDs and sparse component storage
+        std::unique_ptr<ArchetypeStorage> m_archetypeStorage;  // Component storage with StorageMode::Archetype, null otherwise
         std::unique_ptr<SystemManager>    m_systemManager;     // Manages systems
+        std::unique_ptr<JobSystem>        m_jobSystem;         // Worker threads for parallel work
         std::vector<Entity>               m_entitiesToDestroy; // Queue of entities to be destroyed
+
+        std::vector<DestroyGroup>         m_destroyGroups;     // Groups of the current destruction batch; reused between batches
+
+        std::unique_ptr<PerThread<std::unique_ptr<CommandBuffer>>> m_commandBuffers; // Command buffer of each JobSystem thread index
+        std::vector<PlaybackCommand>                               m_playback;       // Scratch list reused by PlaybackCommands
     };
 
 } // namespace ecs
 #include "../src/Coordinator.tpp"
+#include "../src/CommandBuffer.tpp"
 
 #endif //COORDINATOR_HPP
\ No newline at end of file
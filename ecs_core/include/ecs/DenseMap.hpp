@@ -5,23 +5,27 @@
  * DenseMap provides O(1) insertions, lookups, and removals while maintaining
  * data in a contiguous memory layout for better cache performance during iteration.
  * It's particularly useful for storing and accessing component data.
+ *
+ * Integral keys (such as Entity) are resolved through a paged sparse array, any
+ * other key type through a hash map. See SparseIndex.hpp.
  */
 #ifndef DENSEMAP_HPP
 #define DENSEMAP_HPP
 
 #include <vector>
-#include <unordered_map>
 #include <cstddef>
+#include <utility>
 #include "Debug.hpp"
+#include "SparseIndex.hpp"
 
 namespace ecs {
 
-    template <typename Key, typename Value = Key>
+    template <typename Key, typename Value = Key, typename Index = DefaultIndex<Key>>
     class DenseMap
     {
-        std::unordered_map<Key, std::size_t> m_keyToIndex;  // Maps keys to their index in the dense array
-        std::vector<Key>                     m_indexToKey;  // Maps indices to their keys
-        std::vector<Value>                   m_data;        // The actual data, tightly packed
+        Index              m_keyToIndex;  // Maps keys to their index in the dense array
+        std::vector<Key>   m_indexToKey;  // Maps indices to their keys
+        std::vector<Value> m_data;        // The actual data, tightly packed
 
     public:
         DenseMap() = default;
@@ -40,10 +44,10 @@ namespace ecs {
          * @param value The value to associate with the key.
          */
         void Insert(const Key& key, const Value& value) {
-            Debug::Assert(!m_keyToIndex.contains(key),
+            Debug::Assert(!m_keyToIndex.Contains(key),
                 "DenseMap::Insert - Key already exists.");
 
-            m_keyToIndex[key] = m_data.size();
+            m_keyToIndex.Set(key, m_data.size());
             m_indexToKey.push_back(key);
             m_data.push_back(value);
         }
@@ -55,10 +59,10 @@ namespace ecs {
          */
         void Update(const Key& key, const Value& value)
         {
-            Debug::Assert(m_keyToIndex.contains(key),
+            Debug::Assert(Contains(key),
                 "DenseMap::Update - Key does not exists.");
 
-            std::size_t indexOfUpdated = m_keyToIndex.at(key);
+            std::size_t indexOfUpdated = m_keyToIndex.Find(key);
             m_data[indexOfUpdated] = value;
         }
 
@@ -70,27 +74,65 @@ namespace ecs {
          */
         void Erase(const Key& key)
         {
-            Debug::Assert(m_keyToIndex.contains(key),
+            Debug::Assert(Contains(key),
                 "DenseMap::Erase - Key does not exists.");
 
-            std::size_t indexOfRemoved   = m_keyToIndex.at(key);
+            std::size_t indexOfRemoved   = m_keyToIndex.Find(key);
             std::size_t indexOfLast      = m_data.size() - 1;
             Key keyOfLast                = m_indexToKey[indexOfLast];
-            m_data[indexOfRemoved]       = m_data[indexOfLast];
+            m_data[indexOfRemoved]       = std::move(m_data[indexOfLast]);
             m_indexToKey[indexOfRemoved] = keyOfLast;
-            m_keyToIndex[keyOfLast]      = indexOfRemoved;
-            m_keyToIndex.erase(key);
+            m_keyToIndex.Set(keyOfLast, indexOfRemoved);
+            m_keyToIndex.Erase(key);
             m_indexToKey.pop_back();
             m_data.pop_back();
         }
 
+        /**
+         * @brief Exchanges the positions of two keys and their values in the dense arrays.
+         * @param first A key in the map.
+         * @param second Another key in the map.
+         */
+        void Swap(const Key& first, const Key& second)
+        {
+            Debug::Assert(Contains(first) && Contains(second),
+                "DenseMap::Swap - Key does not exists.");
+
+            const std::size_t firstIndex  = m_keyToIndex.Find(first);
+            const std::size_t secondIndex = m_keyToIndex.Find(second);
+            if (firstIndex == secondIndex)
+            {
+                return;
+            }
+
+            // Keys are re-read after the swap since either argument may refer into m_indexToKey
+            std::swap(m_data[firstIndex], m_data[secondIndex]);
+            std::swap(m_indexToKey[firstIndex], m_indexToKey[secondIndex]);
+            m_keyToIndex.Set(m_indexToKey[firstIndex], firstIndex);
+            m_keyToIndex.Set(m_indexToKey[secondIndex], secondIndex);
+        }
+
+        /**
+         * @brief Gets the position of a key in the dense arrays.
+         * @param key A key in the map.
+         * @return Index of the key in the key and data vectors.
+         */
+        std::size_t IndexOf(const Key& key) const
+        {
+            Debug::Assert(Contains(key),
+                "DenseMap::IndexOf - Key does not exists.");
+
+            return m_keyToIndex.Find(key);
+        }
+
         /**
          * @brief Checks if a key exists in the map.
          * @param key The key to check.
          * @return True if the key exists, false otherwise.
          */
         bool Contains(const Key& key) const {
-            return m_keyToIndex.contains(key);
+            const auto index = m_keyToIndex.Find(key);
+            return index != Index::InvalidSlot && m_indexToKey[index] == key;
         }
 
         /**
@@ -102,7 +144,7 @@ namespace ecs {
             Debug::Assert(Contains(key),
                 "DenseMap::GetValue(const) - Key does not exists.");
 
-             return m_data[m_keyToIndex.find(key)->second];
+            return m_data[m_keyToIndex.Find(key)];
         }
 
         /**
@@ -114,7 +156,34 @@ namespace ecs {
             Debug::Assert(Contains(key),
                 "DenseMap::GetValue - Key does not exists.");
 
-            return m_data[m_keyToIndex.find(key)->second];
+            return m_data[m_keyToIndex.Find(key)];
+        }
+
+        /**
+         * @brief Gets a pointer to the value associated with a key, if any.
+         *
+         * Resolves the key once, which makes it cheaper than Contains followed
+         * by GetValue.
+         *
+         * @param key The key to look up.
+         * @return Pointer to the value, or nullptr if the key does not exist.
+         */
+        Value* TryGetValue(const Key& key) {
+            const auto index = m_keyToIndex.Find(key);
+            if (index == Index::InvalidSlot || !(m_indexToKey[index] == key))
+            {
+                return nullptr;
+            }
+
+            return &m_data[index];
+        }
+
+        /**
+         * @brief Gets the keys in the same order as the data vector.
+         * @return Const reference to the key vector.
+         */
+        const std::vector<Key>& GetKeyVector() const {
+            return m_indexToKey;
         }
 
         /**
@@ -147,11 +216,18 @@ namespace ecs {
 
         /**
          * @brief Clears all elements from the map.
+         *
+         * Only the slots of the stored keys are reset, so the cost is proportional
+         * to the number of elements and index pages stay allocated for reuse.
          */
         void Clear() {
-             m_data.clear();
-             m_keyToIndex.clear();
-             m_indexToKey.clear();
+            for (const Key& key : m_indexToKey)
+            {
+                m_keyToIndex.Erase(key);
+            }
+
+            m_data.clear();
+            m_indexToKey.clear();
         }
 
         // Pair structure used for iteration
@@ -189,8 +265,8 @@ namespace ecs {
                     "DenseMap>Iterator::Pair operator* - Iterator out of bounds");
 
                 return Pair {
-                    m_container->m_indexToKey.at(m_index),
-                    m_container->m_data.at(m_index)
+                    m_container->m_indexToKey[m_index],
+                    m_container->m_data[m_index]
                 };
             }
 
@@ -210,6 +286,10 @@ namespace ecs {
         Iterator end() { return Iterator(this, m_data.size()); }
     };
 
+    // DenseMap keyed by entity handles; a stale handle to a recycled slot is not contained
+    template <typename Value = Entity>
+    using EntityMap = DenseMap<Entity, Value, EntitySparseIndex>;
+
 } // namespace ecs
 
 #endif //DENSEMAP_HPP
\ No newline at end of file
@@ -9,10 +9,11 @@
 #ifndef ENTITYMANAGER_HPP
 #define ENTITYMANAGER_HPP
 
+#include <cstddef>
 #include <queue>
-#include <array>
 #include <vector>
 #include "DenseMap.hpp"
+#include "PagedArray.hpp"
 #include "Types.hpp"
 
 namespace ecs {
@@ -21,20 +22,42 @@ namespace ecs {
     class EntityManager
     {
     public:
-        EntityManager();
+        /**
+         * @brief Creates an entity manager.
+         *
+         * No IDs or signatures are allocated up front; both grow with the number
+         * of entities actually created.
+         *
+         * @param maxEntities Maximum number of entities alive at the same time.
+         */
+        explicit EntityManager(std::size_t maxEntities = MaxEntities);
 
         /**
          * @brief Creates a new entity.
-         * @return The created entity ID.
+         *
+         * Recycled slots are reused first, oldest first, with their generation
+         * bumped so that handles to the destroyed entity stay invalid. Fresh slots
+         * are handed out in increasing order until the capacity is reached.
+         *
+         * @return The created entity handle, or NullEntity if the capacity is exhausted.
          */
         Entity CreateEntity();
 
         /**
-         * @brief Destroys an entity, recycling its ID.
+         * @brief Destroys an entity, recycling its slot under the next generation.
          * @param entity The entity to destroy.
          */
         void DestroyEntity(Entity entity);
 
+        /**
+         * @brief Destroys every living entity at once.
+         *
+         * Each slot is recycled under its next generation, exactly as if its
+         * entity had been destroyed, so old handles stay invalid. Storage is
+         * kept for reuse.
+         */
+        void Clear();
+
         /**
          * @brief Get all currently active entities.
          * @return Vector containing all living entity IDs.
@@ -43,6 +66,11 @@ namespace ecs {
 
         /**
          * @brief Checks if an entity is currently active.
+         *
+         * Handles that were destroyed, including ones whose slot has since been
+         * reused by a newer entity, are reported as not alive. Generations wrap
+         * after 4096 reuses of the same slot.
+         *
          * @param entity The entity to check.
          * @return True if the entity is alive, false otherwise.
          */
@@ -62,10 +90,25 @@ namespace ecs {
          */
         Signature GetSignature(Entity entity) const;
 
+        /**
+         * @brief Gets the maximum number of entities alive at the same time.
+         * @return The entity capacity.
+         */
+        std::size_t GetMaxEntities() const;
+
     private:
-        std::queue<Entity>                  m_availableEntities;  // Recycled entity IDs ready for reuse
-        DenseMap<Entity>                    m_livingEntities;     // Currently active entities
-        std::array<Signature, MaxEntities>  m_signatures;         // Component signatures for each entity
+        // Elements per page of the per-slot arrays (one page covers 1024 slots)
+        static constexpr std::size_t SlotPageSize = 1024;
+
+        // Stored for slots with no living entity; its index never matches a real slot
+        static constexpr Entity DeadHandle = MakeEntity(EntityIndexMask, 0);
+
+        std::size_t                           m_maxEntities;        // Capacity given at construction
+        Entity                                m_nextIndex;          // Lowest slot that was never handed out
+        std::queue<Entity>                    m_availableEntities;  // Next handles of recycled slots, ready for reuse
+        EntityMap<>                           m_livingEntities;     // Currently active entities
+        PagedArray<Entity, SlotPageSize>      m_handles;            // Live handle of each slot, or DeadHandle
+        PagedArray<Signature, SlotPageSize>   m_signatures;         // Component signatures for each slot
     };
 
 } // namespace ecs
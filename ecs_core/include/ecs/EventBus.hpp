@@ -3,30 +3,147 @@
  * @brief Event system for decoupled communication between systems.
  *
  * The EventBus allows systems to communicate without direct dependencies
- * through a publish-subscribe pattern.
+ * through a publish-subscribe pattern. Every event type has its own channel
+ * holding a typed queue and the type's listeners, found by the type's
+ * process-wide TypeIndex, so emitting and dispatching need no hashing, type
+ * erasure or allocation per event once the queues have grown. A batch
+ * listener receives all events of its type processed in a call at once.
+ *
+ * Once given a JobSystem, the bus accepts events queued from its worker
+ * threads: each worker queues into its own buffer without locks, and
+ * ProcessEvents merges the buffers by JobSystem order key, so the order does
+ * not depend on which thread ran which system or chunk.
  */
 #ifndef EVENTBUS_HPP
 #define EVENTBUS_HPP
 
-#include <any>
-#include <typeindex>
-#include <unordered_map>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <memory>
+#include <span>
+#include <thread>
+#include <type_traits>
 #include <vector>
-#include <algorithm>
+#include "JobSystem.hpp"
 #include "Types.hpp"
+#include "SystemStats.hpp"
+#include "TypeIndex.hpp"
 #include "ecs/Debug.hpp"
 
 namespace ecs {
 
+    /**
+     * @brief Non-owning reference to a function called with an event.
+     *
+     * Two pointers wide and trivially copyable. The object it is bound to must
+     * outlive the delegate.
+     * @code
+     * eventBus.AddListener(ecs::EventDelegate<CollisionEvent>::Bind<&CollisionResponseSystem::OnCollision>(*this));
+     * @endcode
+     *
+     * @tparam EventType The event type.
+     */
+    template<typename EventType>
+    class EventDelegate
+    {
+    public:
+        EventDelegate() = default;
+
+        /**
+         * @brief Binds a member function to an object.
+         * @tparam Method The member function, callable with a const EventType&.
+         * @tparam T The object's type.
+         * @param instance The object.
+         * @return The delegate.
+         */
+        template<auto Method, typename T>
+        static EventDelegate Bind(T& instance);
+
+        /**
+         * @brief Binds a free function.
+         * @tparam Function The function, callable with a const EventType&.
+         * @return The delegate.
+         */
+        template<auto Function>
+        static EventDelegate Bind();
+
+        /**
+         * @brief Binds a callable object, such as a lambda, by reference.
+         * @param callable The callable, invocable with a const EventType&.
+         * @return The delegate.
+         */
+        template<typename F>
+        static EventDelegate Bind(F& callable);
+
+        /**
+         * @brief Calls the bound function.
+         * @param event The event.
+         */
+        void operator()(const EventType& event) const { m_call(m_object, event); }
+
+        /**
+         * @brief Checks if a function is bound.
+         */
+        explicit operator bool() const { return m_call != nullptr; }
+
+    private:
+        void* m_object = nullptr;                            // Bound object, null for free functions
+        void (*m_call)(void*, const EventType&) = nullptr;   // Calls the bound function on m_object
+    };
+
     class EventBus
     {
     public:
         EventBus();
-        ~EventBus() = default;
+        ~EventBus();
+
+        EventBus(const EventBus&) = delete;
+        EventBus& operator=(const EventBus&) = delete;
+
+        /**
+         * @brief Lets the worker threads of a job system queue events.
+         *
+         * Each worker then queues into its own buffer, so systems that queue
+         * events can run in parallel. Every buffered event carries the
+         * JobSystem order key of the work that queued it, and ProcessEvents
+         * appends the buffers by key after the events queued without one: the
+         * events of Scheduler systems follow the order the systems were added,
+         * and those of ParallelFor chunks the order of the chunks, whichever
+         * thread ran them. Events with the same key keep the order they were
+         * queued in; only plain jobs, which run with key zero, fall back to
+         * thread index order. Call while no events are queued.
+         *
+         * All non-worker threads share the bus's own queue, so the only one of
+         * them that may emit is the bus's owner: the thread that created the bus
+         * or last called ProcessEvents, normally the thread running the
+         * scheduler.
+         *
+         * @param jobs The job system. Must outlive the bus.
+         */
+        void SetJobSystem(JobSystem& jobs);
+
+        /**
+         * @brief Sets whether ProcessEvents dispatches different event types in parallel.
+         *
+         * Each event type queued since the last call is then dispatched as one
+         * job on the job system given to SetJobSystem: events of a type keep
+         * their order and batch listeners still run after the type's
+         * single-event listeners, but there is no order across types. Listeners
+         * of different types must then not touch the same data, and listeners
+         * must not be added or removed during dispatch.
+         *
+         * @param parallel True to dispatch in parallel.
+         */
+        void SetParallelDispatch(bool parallel);
 
         /**
          * @brief Adds a listener for a specific event type.
+         *
+         * The function is stored once here; calling it costs one indirection
+         * more than a delegate.
+         *
          * @tparam EventType The event type to listen for.
          * @param listener The callback function to invoke when event occurs.
          * @return Unique ID for the listener (used for removal).
@@ -35,7 +152,50 @@ namespace ecs {
         ListenerID AddListener(std::function<void(const EventType&)> listener);
 
         /**
-         * @brief Removes a listener for a specific event type.
+         * @brief Adds a listener that calls a delegate, without allocating.
+         * @tparam EventType The event type to listen for.
+         * @param listener The delegate. Its object must stay alive until the listener is removed.
+         * @return Unique ID for the listener (used for removal).
+         */
+        template<typename EventType>
+        ListenerID AddListener(EventDelegate<EventType> listener);
+
+        /**
+         * @brief Adds a member function of an object as listener, without allocating.
+         * @code
+         * eventBus.AddListener<&CollisionResponseSystem::OnCollision>(*this);
+         * @endcode
+         *
+         * @tparam Method Member function taking the event, by value or const reference.
+         * @tparam T The object's type.
+         * @param instance The object. Must stay alive until the listener is removed.
+         * @return Unique ID for the listener (used for removal).
+         */
+        template<auto Method, typename T>
+        ListenerID AddListener(T& instance);
+
+        /**
+         * @brief Adds a listener that receives the events of a type in bulk.
+         *
+         * ProcessEvents calls it once with every queued event of the type, in
+         * emission order, after the single-event listeners have run for all
+         * queued events. Events emitted with fast are passed one at a time.
+         *
+         * @tparam EventType The event type to listen for.
+         * @param listener The callback function to invoke with the events.
+         * @return Unique ID for the listener (used for removal with RemoveListener).
+         */
+        template<typename EventType>
+        ListenerID AddBatchListener(std::function<void(std::span<const EventType>)> listener);
+
+        /**
+         * @brief Removes a listener or batch listener for a specific event type.
+         *
+         * May be called from a listener; a listener removed while its event type
+         * is dispatched is not called any more. Listeners removed during dispatch,
+         * or at any time once a job system is set, are erased by the next
+         * ProcessEvents, when no thread dispatches.
+         *
          * @tparam EventType The event type the listener was registered for.
          * @param listenerID The ID of the listener to remove.
          */
@@ -44,6 +204,13 @@ namespace ecs {
 
         /**
          * @brief Emits an event to all registered listeners.
+         *
+         * May be called from the thread that created the bus or last called
+         * ProcessEvents, and from worker threads of the job system given to
+         * SetJobSystem; any other thread would share the owner's queue. A fast
+         * event is dispatched on the emitting thread, so its type must already
+         * have a listener.
+         *
          * @tparam EventType The type of event to emit.
          * @param event The event data to send.
          * @param fast If true, processes the event immediately; otherwise queues it.
@@ -54,8 +221,11 @@ namespace ecs {
         /**
          * @brief Processes all queued events.
          *
-         * This should be called once per frame to ensure events are processed
-         * at a controlled time.
+         * Events are dispatched in the order they were emitted, across event
+         * types. Batch listeners are called afterwards, type by type in the
+         * order each type was first emitted. Events emitted by listeners
+         * meanwhile are queued for the next call. This should be called once per frame to ensure events are
+         * processed at a controlled time.
          */
         void ProcessEvents();
 
@@ -65,46 +235,119 @@ namespace ecs {
         void UnsubscribeAll();
 
     private:
-        /**
-         * @brief Internal structure to store listener callbacks.
-         */
-        struct ItemListener {
-            ListenerID id;  // Unique ID for this listener
-            std::function<void(const std::any&)> callback;  // Type-erased callback
-
-            ItemListener(const ListenerID id, std::function<void(const std::any&)> cb)
-            : id(id)
-            , callback(std::move(cb))
-            {
-            }
+        // Type-independent part of a channel, for ProcessEvents and UnsubscribeAll
+        struct ChannelBase
+        {
+            virtual ~ChannelBase() = default;
+
+            // Makes the queued events the ones Dispatch hands out, leaving the queue empty for new events
+            virtual void BeginProcessing() = 0;
+
+            // Dispatches the next count events handed out by BeginProcessing
+            virtual void Dispatch(std::size_t count) = 0;
+
+            // Hands every event handed out by BeginProcessing to the batch listeners
+            virtual void DispatchBatch() = 0;
+
+            // Dispatches every event handed out by BeginProcessing, then hands them to the batch listeners
+            virtual void DispatchAll() = 0;
+
+            // Drops the events handed out by BeginProcessing, keeping their storage
+            virtual void EndProcessing() = 0;
+
+            // Drops every listener and queued event
+            virtual void Clear() = 0;
+
+            // Erases the listeners marked removed; only called while no event of the type is dispatched
+            virtual void EraseRemoved() = 0;
+
+            bool              queued = false;   // Whether the channel is in m_queuedChannels
+            std::atomic<bool> removed {false};  // Whether removed listeners wait for EraseRemoved
         };
 
-        /**
-         * @brief Internal structure to store event data.
-         */
-        struct ItemEvent {
-            std::type_index type;  // The type of the event
-            std::any event;        // The event data
-
-            ItemEvent(const std::type_index t, std::any e)
-            : type(t)
-            , event(std::move(e))
-            {
-            }
+        // Queue and listeners of one event type
+        template<typename EventType>
+        struct Channel;
+
+        // Consecutive queued events of one channel. The runs in emission order record the order across channels.
+        struct Run
+        {
+            ChannelBase* channel; // The channel holding the events
+            std::size_t  count;   // Number of events
         };
 
-        ListenerID m_nextListenerID;  // Next available listener ID
-        std::vector<ItemEvent> m_eventQueue;  // Queue of pending events
-        std::unordered_map<std::type_index, std::vector<ItemListener>> m_listeners;  // Maps from event type to listeners
+        // Events of one type queued by a worker thread
+        struct ThreadChannelBase
+        {
+            virtual ~ThreadChannelBase() = default;
 
-        /**
-         * @brief Processes a single event.
-         * @param item The event to process.
-         */
-        void ProcessEvent(const ItemEvent& item);
+            // Moves count events from index first to the bus's channel of the type
+            virtual void Merge(EventBus& bus, std::size_t first, std::size_t count) = 0;
+
+            // Drops the events, keeping their storage
+            virtual void Clear() = 0;
+        };
+
+        template<typename EventType>
+        struct ThreadChannel;
+
+        // Consecutive events of one type queued by a thread with the same order key
+        struct ThreadRun
+        {
+            ThreadChannelBase* channel; // The events' buffer
+            std::size_t        first;   // Index of the first event in the buffer
+            std::size_t        count;   // Number of events
+            std::uint64_t      order;   // JobSystem order key of the work that queued them
+        };
+
+        // Events buffered by one thread index. Aligned so that neighbouring workers do not share a cache line.
+        struct alignas(CacheLineSize) ThreadQueue
+        {
+            std::vector<std::unique_ptr<ThreadChannelBase>> channels; // Buffer of each event type index, null if unused
+            std::vector<ThreadRun>                          runs;     // Queued events in emission order
+        };
+
+        // Dispatches a fast event on the calling thread
+        template<typename EventType>
+        void DispatchNow(const EventType& event);
+
+        // Queues an event into the buffer of the calling thread's index
+        template<typename EventType>
+        void EmitToQueue(const EventType& event, ThreadQueue& queue, std::uint64_t order);
+
+        // Records count events appended to a channel's pending events
+        void Enqueue(ChannelBase& channel, std::size_t count);
+
+        // Moves the buffered events to the channels, in order key order
+        void MergeThreadQueues();
+
+        // Gets the channel of an event type, creating it on first use
+        template<typename EventType>
+        Channel<EventType>& GetChannel();
+
+        // Gets the channel of an event type, or null if it has none
+        template<typename EventType>
+        Channel<EventType>* FindChannel() const;
+
+        // Adds a listener to the channel of its event type
+        template<typename EventType>
+        ListenerID AddListener(EventDelegate<EventType> listener, std::unique_ptr<std::function<void(const EventType&)>> owned);
+
+        ListenerID                                m_nextListenerID;     // Next available listener ID
+        std::vector<std::unique_ptr<ChannelBase>> m_channels;           // Channel of each event type index, null if unused
+        std::vector<Run>                          m_runs;               // Queued events in emission order
+        std::vector<ChannelBase*>                 m_queuedChannels;     // Channels with queued events
+        std::vector<Run>                          m_processingRuns;     // Runs being dispatched by ProcessEvents
+        std::vector<ChannelBase*>                 m_processingChannels; // Channels whose events are being dispatched
+        JobSystem*                                m_jobs;               // Job system whose workers may emit, or null
+        std::thread::id                           m_ownerThread;        // Only non-worker thread that may emit: the creator, or the last to process events
+        std::vector<ThreadQueue>                  m_threadQueues;       // Buffer of each thread index; index 0 only holds events queued with an order key
+        std::vector<const ThreadRun*>             m_mergeRuns;          // Scratch list of the buffered runs, sorted by order key
+        bool                                      m_parallelDispatch;   // Whether event types are dispatched in parallel
+        bool                                      m_processing;         // Whether ProcessEvents is running
     };
 
 } // namespace ecs
 #include "../src/EventBus.tpp"
 
-#endif //EVENTBUS_HPP
\ No newline at end of file
+#endif //EVENTBUS_HPP
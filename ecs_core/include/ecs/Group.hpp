@@ -0,0 +1,115 @@
+/**
+ * @file Group.hpp
+ * @brief Iteration over the members of an owning group.
+ *
+ * An owning group keeps the entities that have all of its component types at
+ * the front of each owned ComponentArray, in the same order. Iterating a group
+ * is therefore a walk over parallel packed arrays with no lookups at all.
+ * Groups are created by Coordinator::Group and maintained by the owned arrays
+ * as components are added and removed.
+ */
+#ifndef GROUP_HPP
+#define GROUP_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <utility>
+#include "ComponentManager.hpp"
+#include "Types.hpp"
+
+namespace ecs {
+
+    /**
+     * @brief Non-owning handle to the members of an owning group.
+     *
+     * Components of the owned types must not be added or removed while the
+     * group is being iterated; destroying entities through the Coordinator is
+     * fine since destruction is deferred.
+     *
+     * @tparam Ts The component types owned by the group.
+     */
+    template<typename... Ts>
+    class Group
+    {
+        static_assert(sizeof...(Ts) > 0, "Group requires at least one component type");
+        static_assert((... && !IsTag<Ts>), "Groups cannot own tag components");
+        static_assert((... && !IsSoA<Ts>), "Groups cannot own SoA components");
+
+    public:
+        /**
+         * @brief Creates a handle to a group.
+         * @param storage The group bookkeeping.
+         * @param arrays The owned arrays, in the order of Ts.
+         */
+        Group(const GroupStorage& storage, ComponentArray<Ts>&... arrays);
+
+        /**
+         * @brief Gets the number of entities in the group.
+         */
+        std::size_t Size() const;
+
+        /**
+         * @brief Calls a function for every member of the group.
+         * @param func Callable as func(Entity, Ts&...).
+         */
+        template<typename Func>
+        void Each(Func&& func);
+
+        // Value produced by the iterator; bind with auto [entity, a, b] = ...
+        using Value = std::tuple<Entity, Ts&...>;
+
+        // Forward iterator over the group members
+        class Iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using difference_type   = std::ptrdiff_t;
+            using value_type        = Value;
+            using pointer           = void;
+            using reference         = Value;
+
+            Iterator(Group* group, std::size_t index)
+                : m_group(group), m_index(index) { }
+
+            Iterator& operator++() { ++m_index; return *this; }
+            Iterator operator++(int) { Iterator temp = *this; ++(*this); return temp; }
+
+            bool operator==(const Iterator& other) const {
+                return (m_group == other.m_group) && (m_index == other.m_index);
+            }
+
+            bool operator!=(const Iterator& other) const {
+                return !(*this == other);
+            }
+
+            Value operator*() const;
+
+        private:
+            Group*      m_group; // The group being iterated
+            std::size_t m_index; // Position in the owned arrays
+        };
+
+        /**
+         * @brief Returns an iterator to the first member.
+         */
+        Iterator begin() { return Iterator(this, 0); }
+
+        /**
+         * @brief Returns an iterator past the last member.
+         */
+        Iterator end() { return Iterator(this, Size()); }
+
+    private:
+        template<typename Func, std::size_t... Is>
+        void EachImpl(Func& func, std::index_sequence<Is...>);
+
+        const GroupStorage*                m_storage; // Group bookkeeping
+        std::tuple<ComponentArray<Ts>*...> m_arrays;  // Owned arrays
+    };
+
+} // namespace ecs
+
+#include "../src/Group.tpp"
+
+#endif //GROUP_HPP
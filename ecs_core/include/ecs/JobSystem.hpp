@@ -0,0 +1,228 @@
+/**
+ * @file JobSystem.hpp
+ * @brief Work-stealing thread pool shared by everything in ecs_core that runs in parallel.
+ *
+ * Each thread taking part in the pool owns a queue of jobs. A thread pushes the
+ * jobs it schedules onto its own queue and runs them newest first, which keeps
+ * freshly produced data in its cache; a thread whose queue is empty steals the
+ * oldest job of another queue. Threads that are not workers of the pool, such
+ * as the main thread, share one extra queue and help run jobs while they wait.
+ */
+#ifndef JOBSYSTEM_HPP
+#define JOBSYSTEM_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "Types.hpp"
+
+namespace ecs {
+
+    class JobSystem;
+
+    /**
+     * @brief Handle to a scheduled job, used to wait for it or to make other jobs depend on it.
+     *
+     * Handles are cheap to copy. A default-constructed handle refers to no job
+     * and counts as finished.
+     */
+    class JobHandle
+    {
+    public:
+        JobHandle() = default;
+
+        /**
+         * @brief Checks if the job has finished, or if the handle refers to no job.
+         */
+        bool IsDone() const;
+
+    private:
+        friend class JobSystem;
+
+        struct Job;
+
+        explicit JobHandle(std::shared_ptr<Job> job) : m_job(std::move(job)) {}
+
+        std::shared_ptr<Job> m_job; // The job, shared with the queue and the jobs depending on it
+    };
+
+    /**
+     * @brief Pool of worker threads with per-thread work-stealing queues.
+     */
+    class JobSystem
+    {
+    public:
+        // Work run by a job
+        using Job = std::function<void()>;
+
+        /**
+         * @brief Creates the pool and starts its worker threads.
+         *
+         * Threads that wait for jobs run jobs themselves, so workerCount
+         * threads are started in addition to the ones that schedule work. With
+         * no workers every job runs on a waiting thread.
+         *
+         * @param workerCount Number of worker threads.
+         */
+        explicit JobSystem(std::size_t workerCount = GetDefaultWorkerCount());
+
+        /**
+         * @brief Runs the jobs still queued, then stops and joins the worker threads.
+         */
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        /**
+         * @brief Schedules a job that may start right away.
+         * @param job The work to run.
+         * @return Handle to the job.
+         */
+        JobHandle Schedule(Job job);
+
+        /**
+         * @brief Schedules a job that starts once other jobs finished.
+         * @param job The work to run.
+         * @param dependencies Jobs that must finish first. Finished and empty handles are ignored.
+         * @return Handle to the job.
+         */
+        JobHandle Schedule(Job job, std::span<const JobHandle> dependencies);
+
+        /**
+         * @brief Blocks until a job finished, running queued jobs meanwhile.
+         *
+         * May be called from inside a job, which lets jobs wait for jobs they
+         * scheduled without tying up a worker.
+         *
+         * @param handle The job to wait for.
+         */
+        void Wait(const JobHandle& handle);
+
+        /**
+         * @brief Blocks until every given job finished, running queued jobs meanwhile.
+         * @param handles The jobs to wait for.
+         */
+        void Wait(std::span<const JobHandle> handles);
+
+        /**
+         * @brief Calls a function over an index range split into chunks run in parallel.
+         *
+         * The range is cut into chunks of grain indices (the last one may be
+         * shorter), and function(begin, end) is called once per chunk. Chunks are
+         * handed out one at a time to the calling thread and up to one job per
+         * worker, so uneven chunks balance out. Returns once every chunk ran.
+         * Chunk i runs with the calling thread's order key plus i + 1 (see
+         * GetOrderKey), whichever thread runs it.
+         * @code
+         * jobs.ParallelFor(0, positions.size(), 1024, [&](std::size_t begin, std::size_t end)
+         * {
+         *     for (std::size_t i = begin; i < end; ++i)
+         *     {
+         *         positions[i] += velocities[i] * dt;
+         *     }
+         * });
+         * @endcode
+         *
+         * @param begin First index.
+         * @param end One past the last index.
+         * @param grain Number of indices per chunk. Zero is treated as one.
+         * @param function Callable taking (std::size_t begin, std::size_t end).
+         */
+        template<typename F>
+        void ParallelFor(std::size_t begin, std::size_t end, std::size_t grain, F&& function);
+
+        /**
+         * @brief Gets the number of worker threads.
+         */
+        std::size_t GetWorkerCount() const { return m_workers.size(); }
+
+        /**
+         * @brief Gets the number of distinct thread indices, the workers plus one for other threads.
+         */
+        std::size_t GetThreadCount() const { return m_queues.size(); }
+
+        /**
+         * @brief Gets the index of the calling thread in this pool.
+         *
+         * Workers have indices 1 to GetWorkerCount(); every other thread has
+         * index 0. Useful for per-thread scratch data.
+         *
+         * @return The index, below GetThreadCount().
+         */
+        std::size_t GetThreadIndex() const;
+
+        /**
+         * @brief Gets the worker count used by default: one less than the hardware threads.
+         */
+        static std::size_t GetDefaultWorkerCount();
+
+        /**
+         * @brief Gets the order key of the work the calling thread runs.
+         *
+         * Keys follow the order the work would have on a single thread,
+         * whichever thread runs it, so results gathered from several threads
+         * can be put in an order that does not depend on timing. The upper 32
+         * bits count the Scheduler systems started by the thread's program
+         * order; the lower 32 bits count the ParallelFor chunks started within
+         * the system. Each ParallelFor chunk gets its own key and the calling
+         * thread continues past the last chunk's key; chunks of a ParallelFor
+         * started from a chunk share keys with their parent's chunks. Plain
+         * jobs run with key zero.
+         */
+        static std::uint64_t GetOrderKey() { return s_orderKey; }
+
+        /**
+         * @brief Sets the order key of the calling thread.
+         * @param key The new key.
+         * @return The previous key.
+         */
+        static std::uint64_t SetOrderKey(const std::uint64_t key) { return std::exchange(s_orderKey, key); }
+
+    private:
+        // Jobs of one thread, or of all non-worker threads for index 0. Aligned so that
+        // the locks of neighbouring queues do not share a cache line.
+        struct alignas(CacheLineSize) Queue
+        {
+            std::mutex                                   mutex; // Guards jobs
+            std::deque<std::shared_ptr<JobHandle::Job>>  jobs;  // Owner takes from the back, thieves from the front
+        };
+
+        // Queues a job whose dependencies finished on the calling thread's queue
+        void Push(std::shared_ptr<JobHandle::Job> job);
+
+        // Takes a job from the thread's own queue, or steals one; returns null when every queue is empty
+        std::shared_ptr<JobHandle::Job> Take(std::size_t thread);
+
+        // Runs a job, then queues the dependents it was the last dependency of
+        void Run(JobHandle::Job& job);
+
+        // Body of the worker threads
+        void WorkerLoop(std::size_t thread);
+
+        std::vector<Queue>       m_queues;   // Queue of each thread index
+        std::vector<std::thread> m_workers;  // Worker threads
+
+        std::atomic<std::size_t> m_epoch;    // Bumped whenever a job is queued, so sleepers can spot missed work
+        std::atomic<std::size_t> m_sleeping; // Workers waiting on m_wake
+        std::mutex               m_sleepMutex; // Guards waiting on m_wake
+        std::condition_variable  m_wake;     // Signalled when jobs are queued or on shutdown
+        bool                     m_stopping; // Set when the workers should exit, guarded by m_sleepMutex
+
+        inline static thread_local std::uint64_t s_orderKey = 0; // Order key of the work the thread runs
+    };
+
+} // namespace ecs
+
+#include "../src/JobSystem.tpp"
+
+#endif //JOBSYSTEM_HPP
@@ -0,0 +1,118 @@
+/**
+ * @file PagedArray.hpp
+ * @brief Growable array split into lazily allocated fixed-size pages.
+ *
+ * PagedArray behaves like an unbounded array indexed by integers. Storage is
+ * only allocated for pages that have been written to, and existing elements
+ * never move when the array grows, so large and sparse index ranges stay cheap.
+ */
+#ifndef PAGEDARRAY_HPP
+#define PAGEDARRAY_HPP
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace ecs {
+
+    /**
+     * @brief Array of fixed-size pages that are allocated on first write.
+     * @tparam T The element type.
+     * @tparam PageSize Number of elements per page.
+     */
+    template <typename T, std::size_t PageSize>
+    class PagedArray
+    {
+    public:
+        /**
+         * @brief Creates an empty array.
+         * @param fill The value of every element that has not been written yet.
+         */
+        explicit PagedArray(const T& fill = T())
+        : m_fill(fill)
+        {
+        }
+
+        PagedArray(PagedArray&&) noexcept = default;
+        PagedArray& operator=(PagedArray&&) noexcept = default;
+
+        PagedArray(const PagedArray& other)
+        : m_fill(other.m_fill)
+        {
+            *this = other;
+        }
+
+        PagedArray& operator=(const PagedArray& other) {
+            if (this == &other)
+            {
+                return *this;
+            }
+
+            m_fill = other.m_fill;
+            m_pages.clear();
+            m_pages.resize(other.m_pages.size());
+            for (std::size_t i = 0; i < other.m_pages.size(); ++i)
+            {
+                if (other.m_pages[i])
+                {
+                    m_pages[i] = std::make_unique<Page>(*other.m_pages[i]);
+                }
+            }
+
+            return *this;
+        }
+
+        /**
+         * @brief Reads an element without allocating.
+         * @param index The element index.
+         * @return The element, or the fill value if its page does not exist.
+         */
+        const T& Get(const std::size_t index) const {
+            const std::size_t page = index / PageSize;
+            if (page >= m_pages.size() || !m_pages[page])
+            {
+                return m_fill;
+            }
+
+            return (*m_pages[page])[index % PageSize];
+        }
+
+        /**
+         * @brief Gets a writable element, allocating its page if needed.
+         * @param index The element index.
+         * @return Reference to the element.
+         */
+        T& At(const std::size_t index) {
+            const std::size_t page = index / PageSize;
+            if (page >= m_pages.size())
+            {
+                m_pages.resize(page + 1);
+            }
+
+            if (!m_pages[page])
+            {
+                m_pages[page] = std::make_unique<Page>();
+                m_pages[page]->fill(m_fill);
+            }
+
+            return (*m_pages[page])[index % PageSize];
+        }
+
+        /**
+         * @brief Releases every page.
+         */
+        void Clear() {
+            m_pages.clear();
+        }
+
+    private:
+        using Page = std::array<T, PageSize>;
+
+        std::vector<std::unique_ptr<Page>> m_pages; // Lazily allocated pages
+        T                                  m_fill;  // Value of elements that were never written
+    };
+
+} // namespace ecs
+
+#endif //PAGEDARRAY_HPP
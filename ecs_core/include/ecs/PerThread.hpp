@@ -0,0 +1,98 @@
+/**
+ * @file PerThread.hpp
+ * @brief One value per JobSystem thread, for collecting results of parallel loops.
+ *
+ * Each thread of a parallel loop appends to or accumulates into its own value,
+ * so no locks are needed, and the values are merged once the loop returned.
+ * Every value sits on its own cache lines, so threads writing their values at
+ * the same time do not invalidate each other's caches.
+ */
+#ifndef PERTHREAD_HPP
+#define PERTHREAD_HPP
+
+#include <cstddef>
+#include <vector>
+#include "JobSystem.hpp"
+#include "Types.hpp"
+
+namespace ecs {
+
+    /**
+     * @brief A value for each thread index of a JobSystem.
+     *
+     * All non-worker threads share index 0, so only one of them may use Local
+     * at a time, normally the thread that started the parallel loop.
+     * @code
+     * PerThread<std::vector<CollisionEvent>> hits(coordinator.GetJobSystem());
+     * ParallelEach(64, [&](Entity entity)
+     * {
+     *     if (Collides(entity))
+     *     {
+     *         hits.Local().push_back({entity, other});
+     *     }
+     * });
+     * hits.ForEach([&](std::vector<CollisionEvent>& events)
+     * {
+     *     all.insert(all.end(), events.begin(), events.end());
+     *     events.clear();
+     * });
+     * @endcode
+     *
+     * @tparam T Type of the value.
+     */
+    template<typename T>
+    class PerThread
+    {
+    public:
+        /**
+         * @brief Creates a value-initialized value for every thread index.
+         * @param jobs The job system the values are used with. Must outlive this.
+         */
+        explicit PerThread(const JobSystem& jobs)
+        : m_jobs(jobs)
+        , m_slots(jobs.GetThreadCount())
+        {
+        }
+
+        /**
+         * @brief Gets the value of the calling thread.
+         * @return Reference to the value.
+         */
+        T& Local() { return m_slots[m_jobs.GetThreadIndex()].value; }
+
+        /**
+         * @brief Calls a function with every value, in thread index order.
+         *
+         * Which thread ran which part of a loop depends on timing, so results
+         * whose order matters should be sorted after merging.
+         *
+         * @param function Callable taking T&.
+         */
+        template<typename F>
+        void ForEach(F&& function)
+        {
+            for (Slot& slot : m_slots)
+            {
+                function(slot.value);
+            }
+        }
+
+        /**
+         * @brief Gets the number of values, one per thread index.
+         */
+        std::size_t Size() const { return m_slots.size(); }
+
+    private:
+        // A value padded to whole cache lines
+        struct alignas(CacheLineSize) Slot
+        {
+            T value {};
+        };
+
+        const JobSystem&  m_jobs;  // Provides the calling thread's index
+        std::vector<Slot> m_slots; // Value of each thread index
+    };
+
+} // namespace ecs
+
+#endif //PERTHREAD_HPP
@@ -0,0 +1,154 @@
+/**
+ * @file PhaseScheduler.hpp
+ * @brief Frame loop that runs systems in named phases with a fixed simulation tick.
+ *
+ * A frame runs the Input phase once with the frame's delta time, then the
+ * simulation phases (PreSim, Sim, PostSim) as many times as whole fixed steps
+ * fit into the time accumulated so far, each with the fixed step as delta
+ * time. The Render phase runs separately, once per frame. The fraction of a
+ * step left over is exposed as an interpolation alpha, so rendering can blend
+ * the last two simulated states and stay smooth at any display rate.
+ */
+#ifndef PHASESCHEDULER_HPP
+#define PHASESCHEDULER_HPP
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <string>
+#include "JobSystem.hpp"
+#include "Scheduler.hpp"
+#include "System.hpp"
+#include "SystemAccess.hpp"
+
+namespace ecs {
+
+    /**
+     * @brief Phases of a frame, in the order they run.
+     */
+    enum class Phase : std::size_t
+    {
+        Input,   // Once per frame, before the simulation
+        PreSim,  // Start of every fixed step
+        Sim,     // Every fixed step
+        PostSim, // End of every fixed step
+        Render   // Once per frame, from PhaseScheduler::Render
+    };
+
+    // Number of values of Phase
+    constexpr std::size_t PhaseCount = 5;
+
+    /**
+     * @brief Runs systems registered into phases, stepping the simulation phases at a fixed rate.
+     *
+     * Within a phase, systems are scheduled like in a Scheduler: in the order
+     * they were added, in parallel where their accesses allow it.
+     */
+    class PhaseScheduler
+    {
+    public:
+        /**
+         * @brief Creates an empty phase scheduler.
+         * @param jobs The job system running the systems. Must outlive the scheduler.
+         * @param fixedStep Simulated seconds per step.
+         * @param maxSteps Most steps run in one Update. Time beyond that is dropped,
+         *                 so a slow frame slows the simulation down instead of making
+         *                 every following frame slower.
+         */
+        explicit PhaseScheduler(JobSystem& jobs, float fixedStep = 1.f / 60.f, std::size_t maxSteps = 5);
+
+        /**
+         * @brief Adds a system to a phase, scheduled by the access it declares.
+         * @param phase The phase to run the system in.
+         * @param name Name shown in the schedule dump.
+         * @param system The system.
+         */
+        void Add(Phase phase, std::string name, std::shared_ptr<System> system);
+
+        /**
+         * @brief Adds a task, such as a sync point, to a phase.
+         * @param phase The phase to run the task in.
+         * @param name Name shown in the schedule dump.
+         * @param task The work to run.
+         * @param access What the task touches.
+         */
+        void Add(Phase phase, std::string name, Scheduler::Task task, const SystemAccess& access);
+
+        /**
+         * @brief Runs the Input phase, then as many fixed steps as the accumulated time allows.
+         *
+         * Input systems receive frameDt; PreSim, Sim and PostSim systems receive
+         * the fixed step. Updates the interpolation alpha.
+         *
+         * @param frameDt Real seconds since the last frame.
+         * @return Number of fixed steps run, at most the max steps.
+         */
+        std::size_t Update(float frameDt);
+
+        /**
+         * @brief Runs the Render phase.
+         * @param frameDt Real seconds since the last frame.
+         */
+        void Render(float frameDt);
+
+        /**
+         * @brief Gets how far the time since the last fixed step is into the next one.
+         *
+         * Rendering the state of the last two steps blended by this value
+         * (previous + (current - previous) * alpha) shows the simulation at the
+         * current time, one step behind.
+         *
+         * @return The alpha, in [0, 1).
+         */
+        float GetAlpha() const { return m_alpha; }
+
+        /**
+         * @brief Gets the simulated seconds per step.
+         */
+        float GetFixedStep() const { return m_fixedStep; }
+
+        /**
+         * @brief Sets the simulated seconds per step.
+         * @param fixedStep Seconds per step; must be positive.
+         */
+        void SetFixedStep(float fixedStep);
+
+        /**
+         * @brief Gets the most steps run in one Update.
+         */
+        std::size_t GetMaxSteps() const { return m_maxSteps; }
+
+        /**
+         * @brief Sets the most steps run in one Update.
+         * @param maxSteps Step limit; must be positive.
+         */
+        void SetMaxSteps(std::size_t maxSteps);
+
+        /**
+         * @brief Gets the scheduler of a phase, for its timing.
+         * @param phase The phase.
+         * @return The scheduler.
+         */
+        const Scheduler& GetScheduler(Phase phase) const { return m_phases[static_cast<std::size_t>(phase)]; }
+
+        /**
+         * @brief Writes the schedule of every non-empty phase.
+         * @param out Stream to write to.
+         */
+        void DumpSchedule(std::ostream& out) const;
+
+    private:
+        Scheduler& GetScheduler(Phase phase) { return m_phases[static_cast<std::size_t>(phase)]; }
+
+        std::array<Scheduler, PhaseCount> m_phases;      // Scheduler of each phase
+        std::array<bool, PhaseCount>      m_used;        // Whether anything was added to each phase
+        float                             m_fixedStep;   // Simulated seconds per step
+        std::size_t                       m_maxSteps;    // Step limit per Update
+        float                             m_accumulator; // Real time not simulated yet
+        float                             m_alpha;       // m_accumulator as a fraction of a step
+    };
+
+} // namespace ecs
+
+#endif //PHASESCHEDULER_HPP
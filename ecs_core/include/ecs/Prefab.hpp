@@ -0,0 +1,86 @@
+/**
+ * @file Prefab.hpp
+ * @brief Reusable bundles of components for creating entities in bulk.
+ *
+ * A Prefab holds one value of each of its component types together with the
+ * signature they add up to. Coordinator::Instantiate creates any number of
+ * entities from it: components are copied in type by type, every entity gets
+ * its final signature in one step, and system membership for that signature is
+ * worked out once for the whole batch instead of once per added component.
+ */
+#ifndef PREFAB_HPP
+#define PREFAB_HPP
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+#include "Debug.hpp"
+#include "TypeIndex.hpp"
+#include "Types.hpp"
+
+namespace ecs {
+
+    class Coordinator;
+
+    /**
+     * @brief A bundle of component values, created with Coordinator::CreatePrefab.
+     *
+     * Prefabs are move-only. The stored values can be changed through Find
+     * between instantiations; the set of component types is fixed.
+     */
+    class Prefab
+    {
+    public:
+        Prefab(Prefab&&) noexcept = default;
+        Prefab& operator=(Prefab&&) noexcept = default;
+
+        Prefab(const Prefab&) = delete;
+        Prefab& operator=(const Prefab&) = delete;
+
+        /**
+         * @brief Gets the signature every instance starts with.
+         * @return The signature of the bundled components.
+         */
+        Signature GetSignature() const { return m_signature; }
+
+        /**
+         * @brief Checks if the prefab contains a component type.
+         * @tparam T The component type.
+         * @return True if the prefab has a T, false otherwise.
+         */
+        template<typename T>
+        bool Has() const;
+
+        /**
+         * @brief Finds the stored value of a component.
+         * @tparam T The component type.
+         * @return Pointer to the value copied into new instances, or null if the prefab has no T.
+         */
+        template<typename T>
+        T* Find();
+
+    private:
+        friend class Coordinator;
+
+        // Copies a component value into the storage of each entity, without touching signatures
+        using InsertFunction = void (*)(Coordinator& coordinator, std::span<const Entity> entities, const void* component);
+
+        struct Entry
+        {
+            std::size_t                             typeIndex; // Process-wide component type index
+            std::unique_ptr<void, void (*)(void*)>  component; // The value, owned
+            InsertFunction                          insert;    // Adds copies of the value to entities
+        };
+
+        Prefab() = default;
+
+        Signature          m_signature; // Component types of the bundle
+        std::vector<Entry> m_entries;   // One entry per component type
+    };
+
+} // namespace ecs
+
+#include "../src/Prefab.tpp"
+
+#endif //PREFAB_HPP
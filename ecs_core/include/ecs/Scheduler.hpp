@@ -0,0 +1,157 @@
+/**
+ * @file Scheduler.hpp
+ * @brief Runs systems in parallel where their declared accesses allow it.
+ *
+ * Systems are added in the order they would run on a single thread. Whenever
+ * two of them conflict (see SystemAccess), the one added later depends on the
+ * one added earlier; the dependencies form a graph that the Scheduler walks
+ * each Update, running every system whose dependencies have finished as a job
+ * of a JobSystem. Conflicting systems therefore always run in the order they
+ * were added, and results do not depend on thread timing.
+ */
+#ifndef SCHEDULER_HPP
+#define SCHEDULER_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "JobSystem.hpp"
+#include "System.hpp"
+#include "SystemAccess.hpp"
+
+namespace ecs {
+
+    /**
+     * @brief Timing of the last Scheduler::Update.
+     */
+    struct FrameTiming
+    {
+        std::chrono::nanoseconds wall         {0}; // Time Update took
+        std::chrono::nanoseconds serial       {0}; // Sum of the time of every system, i.e. the single-threaded cost
+        std::chrono::nanoseconds criticalPath {0}; // Longest chain of dependent systems, the lower bound of wall
+    };
+
+    /**
+     * @brief Dependency-ordered parallel runner for systems.
+     */
+    class Scheduler
+    {
+    public:
+        // Work run by the scheduler, called with the dt given to Update
+        using Task = std::function<void(float dt)>;
+
+        /**
+         * @brief Creates a scheduler running its systems on a job system.
+         *
+         * The thread calling Update takes part in the work. With a job system
+         * without workers every system runs on the calling thread, in the order
+         * it was added.
+         *
+         * @param jobs The job system, usually Coordinator::GetJobSystem(). Must outlive the scheduler.
+         */
+        explicit Scheduler(JobSystem& jobs);
+
+        Scheduler(const Scheduler&) = delete;
+        Scheduler& operator=(const Scheduler&) = delete;
+
+        /**
+         * @brief Adds a system, scheduled by the access it declares.
+         *
+         * The system is run through System::UpdateIfDue, so a system with an
+         * update rate skips the Updates it is not due in. Its dependents still
+         * wait for it, which keeps the order of the others unchanged.
+         *
+         * @param name Name shown in the schedule dump.
+         * @param system The system.
+         */
+        void Add(std::string name, std::shared_ptr<System> system);
+
+        /**
+         * @brief Adds a task, such as a sync point between systems.
+         * @param name Name shown in the schedule dump.
+         * @param task The work to run.
+         * @param access What the task touches. Use SystemAccess().Exclusive() for sync points.
+         */
+        void Add(std::string name, Task task, const SystemAccess& access);
+
+        /**
+         * @brief Runs every system once and returns when all of them finished.
+         *
+         * Systems are handed to the job system in the order they were added.
+         * Main-thread and exclusive systems run on the calling thread once their
+         * dependencies finished, so systems added after them are handed over
+         * only then. Each system runs with its own JobSystem order key, counted
+         * on from the calling thread's in the order the systems were added, so
+         * events they queue are merged in that order whichever thread ran them.
+         * Must not be called from a system or task of the same scheduler.
+         *
+         * @param dt Delta time passed to every system.
+         */
+        void Update(float dt);
+
+        /**
+         * @brief Writes the dependency graph and the timing of the last Update.
+         *
+         * Each system is listed with its level (the length of the longest chain
+         * of systems it waits for), whether it is tied to the updating thread,
+         * its update rate and time budget if set, the systems it directly waits
+         * for, and its last run time. Systems on
+         * the last critical path are marked with '*'.
+         *
+         * @param out Stream to write to.
+         */
+        void DumpSchedule(std::ostream& out) const;
+
+        /**
+         * @brief Gets the timing of the last Update.
+         */
+        const FrameTiming& GetFrameTiming() const { return m_timing; }
+
+        /**
+         * @brief Gets the number of worker threads, not counting the updating thread.
+         */
+        std::size_t GetWorkerCount() const { return m_jobs.GetWorkerCount(); }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Node
+        {
+            std::string              name;         // Name for the dump
+            std::shared_ptr<System>  system;       // The system run by the task; null for plain tasks
+            Task                     task;         // Work to run
+            SystemAccess             access;       // What the work touches
+            std::vector<std::size_t> dependencies; // Earlier nodes it conflicts with, ascending
+            std::size_t              level;        // Longest chain of dependencies before it
+            Clock::time_point        start;        // Start of the last run
+            Clock::time_point        end;          // End of the last run
+        };
+
+        // Adds the edges from earlier nodes to the last node
+        void Connect();
+
+        // Runs a node and records its timing
+        void Run(std::size_t node);
+
+        // Computes the timing of the finished Update
+        void MeasureFrame(Clock::time_point start, Clock::time_point end);
+
+        JobSystem&               m_jobs;         // Runs the nodes
+        std::vector<Node>        m_nodes;        // Systems and tasks in the order they were added
+        std::vector<JobHandle>   m_handles;      // Job of each node in the current Update; empty for main-thread nodes
+        std::vector<JobHandle>   m_dependencies; // Scratch list of the jobs a node waits for
+        float                    m_dt;           // Delta time of the current Update
+        std::uint64_t            m_orderBase;    // Upper half of the order key of the first node in the current Update
+        bool                     m_updating;     // Set during Update
+        FrameTiming              m_timing;       // Timing of the last Update
+        std::vector<std::chrono::nanoseconds> m_finish; // Critical path ending at each node, for the last Update
+    };
+
+} // namespace ecs
+
+#endif //SCHEDULER_HPP
@@ -0,0 +1,59 @@
+/**
+ * @file SimdKernels.hpp
+ * @brief Vectorized reference kernels over float component columns.
+ *
+ * The kernels work on the packed columns of an SoAComponentArray. The
+ * instruction set is chosen at compile time: AVX2 when the library is built
+ * with SIMPLYECS_ENABLE_AVX2 (or any other flags that define __AVX2__), SSE2 on
+ * x86 targets that have it, and a scalar loop everywhere else. Columns do not
+ * need any particular alignment.
+ */
+#ifndef SIMDKERNELS_HPP
+#define SIMDKERNELS_HPP
+
+#include <cstddef>
+
+namespace ecs {
+    /**
+     * @brief Kernels over float columns.
+     */
+    namespace Simd {
+        /**
+         * @brief Gets the instruction set the kernels were compiled for.
+         * @return "AVX2", "SSE2" or "Scalar".
+         */
+        const char* GetInstructionSet();
+
+        /**
+         * @brief Advances positions by their velocities: positions[i] += velocities[i] * dt.
+         *
+         * Call once per axis, e.g. with the position.x and velocity.x columns.
+         *
+         * @param positions Column of positions, updated in place.
+         * @param velocities Column of velocities, in the same entity order.
+         * @param dt Time step in seconds.
+         * @param count Number of entries in both columns.
+         */
+        void IntegratePositions(float* positions, const float* velocities, float dt, std::size_t count);
+
+        /**
+         * @brief Clamps every value into [min, max].
+         * @param values Column of values, updated in place.
+         * @param min Lower bound.
+         * @param max Upper bound, not less than min.
+         * @param count Number of entries in the column.
+         */
+        void ClampToBounds(float* values, float min, float max, std::size_t count);
+
+        /**
+         * @brief Subtracts the elapsed time from every remaining lifespan.
+         * @param remaining Column of remaining lifespans, updated in place.
+         * @param dt Elapsed time in seconds.
+         * @param count Number of entries in the column.
+         * @return The number of lifespans that are now zero or below.
+         */
+        std::size_t DecrementLifespans(float* remaining, float dt, std::size_t count);
+    } // namespace Simd
+} // namespace ecs
+
+#endif //SIMDKERNELS_HPP
@@ -0,0 +1,64 @@
+/**
+ * @file SoALayout.hpp
+ * @brief Opt-in structure-of-arrays layout for float-only components.
+ *
+ * A component that is made only of floats (directly or through nested structs
+ * such as Vec2<float>) can be stored as one float column per field instead of
+ * one struct per entity. Fields are numbered in declaration order, so a
+ * struct { Vec2<float> position; float rotation; } gets the lanes
+ * position.x = 0, position.y = 1 and rotation = 2.
+ *
+ * To opt a component in, specialize SoALayout before registering it:
+ * @code
+ * template<> struct ecs::SoALayout<LifespanComponent> : std::true_type { };
+ * @endcode
+ */
+#ifndef SOALAYOUT_HPP
+#define SOALAYOUT_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+namespace ecs {
+
+    /**
+     * @brief Selects structure-of-arrays storage for a component type.
+     *
+     * Specialize as std::true_type to store T in an SoAComponentArray. Such
+     * components have no addressable object, so they are read and written
+     * through the array columns instead of Coordinator::GetComponent.
+     *
+     * @tparam T The component type.
+     */
+    template<typename T>
+    struct SoALayout : std::false_type { };
+
+    /**
+     * @brief True if a component type uses structure-of-arrays storage.
+     */
+    template<typename T>
+    inline constexpr bool IsSoA = SoALayout<T>::value;
+
+    /**
+     * @brief Number of float lanes, and therefore columns, of an SoA component.
+     */
+    template<typename T>
+    inline constexpr std::size_t SoALaneCount = sizeof(T) / sizeof(float);
+
+    /**
+     * @brief Gets the lane of a field from its byte offset.
+     *
+     * Meant to be used with offsetof, e.g. SoALane(offsetof(LifespanComponent, remaining)).
+     * For a Vec2<float> field the lane of y is the lane of the field plus one.
+     *
+     * @param offset Byte offset of the field inside the component.
+     * @return The lane index.
+     */
+    constexpr std::size_t SoALane(const std::size_t offset)
+    {
+        return offset / sizeof(float);
+    }
+
+} // namespace ecs
+
+#endif //SOALAYOUT_HPP
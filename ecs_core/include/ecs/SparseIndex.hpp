@@ -0,0 +1,160 @@
+/**
+ * @file SparseIndex.hpp
+ * @brief Key-to-slot index backends used by DenseMap.
+ *
+ * DenseMap keeps its values packed in a vector and needs a way to map a key to
+ * the slot that holds it. For integral keys such as Entity this is done with a
+ * paged sparse array that resolves a key with two array reads; other key types
+ * fall back to a hash map.
+ */
+#ifndef SPARSEINDEX_HPP
+#define SPARSEINDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <unordered_map>
+#include "Debug.hpp"
+#include "PagedArray.hpp"
+#include "Types.hpp"
+
+namespace ecs {
+
+    /**
+     * @brief Uses an integral key as its own array offset.
+     */
+    struct IdentityOffset
+    {
+        template <typename Key>
+        std::size_t operator()(const Key& key) const { return static_cast<std::size_t>(key); }
+    };
+
+    /**
+     * @brief Uses the slot index of an entity handle as its array offset.
+     *
+     * Handles that share a slot but differ in generation map to the same offset,
+     * so the owner of the index must compare the stored key to tell them apart.
+     */
+    struct EntityOffset
+    {
+        std::size_t operator()(const Entity entity) const { return GetEntityIndex(entity); }
+    };
+
+    /**
+     * @brief Paged sparse array mapping integral keys directly to dense slots.
+     *
+     * The key space is split into fixed-size pages that are allocated the first
+     * time a key inside them is set, so a handful of high keys does not force
+     * the whole range to be reserved. Each live entry costs 4 bytes.
+     *
+     * @tparam Key An integral key type.
+     * @tparam ToOffset Maps a key to its position in the sparse array.
+     */
+    template <typename Key, typename ToOffset = IdentityOffset>
+    class SparseIndex
+    {
+        static_assert(std::is_integral_v<Key>, "SparseIndex requires an integral key type");
+
+    public:
+        using Slot = std::uint32_t;
+
+        static constexpr Slot        InvalidSlot = std::numeric_limits<Slot>::max();
+        static constexpr std::size_t PageSize    = 1024; // Slots per page (4 KiB)
+
+        SparseIndex()
+        : m_slots(InvalidSlot)
+        {
+        }
+
+        /**
+         * @brief Gets the slot stored for a key.
+         * @param key The key to look up.
+         * @return The dense slot, or InvalidSlot if the key is not present.
+         */
+        Slot Find(const Key& key) const {
+            return m_slots.Get(ToOffset()(key));
+        }
+
+        /**
+         * @brief Checks if a key has a slot assigned.
+         * @param key The key to check.
+         * @return True if the key is present, false otherwise.
+         */
+        bool Contains(const Key& key) const {
+            return Find(key) != InvalidSlot;
+        }
+
+        /**
+         * @brief Assigns a slot to a key, allocating its page if needed.
+         * @param key The key to assign.
+         * @param slot The dense slot for the key.
+         */
+        void Set(const Key& key, const std::size_t slot) {
+            Debug::Assert(slot < InvalidSlot,
+                "SparseIndex::Set - Slot out of range: %zu", slot);
+
+            m_slots.At(ToOffset()(key)) = static_cast<Slot>(slot);
+        }
+
+        /**
+         * @brief Removes the slot assigned to a key. Pages are kept for reuse.
+         * @param key The key to remove.
+         */
+        void Erase(const Key& key) {
+            Debug::Assert(Contains(key),
+                "SparseIndex::Erase - Key does not exists.");
+
+            m_slots.At(ToOffset()(key)) = InvalidSlot;
+        }
+
+        /**
+         * @brief Releases every page.
+         */
+        void Clear() {
+            m_slots.Clear();
+        }
+
+    private:
+        PagedArray<Slot, PageSize> m_slots; // Lazily allocated pages of slots
+    };
+
+    /**
+     * @brief Hash map based index for keys that cannot be used as array offsets.
+     * @tparam Key Any hashable key type.
+     */
+    template <typename Key>
+    class HashIndex
+    {
+    public:
+        using Slot = std::size_t;
+
+        static constexpr Slot InvalidSlot = std::numeric_limits<Slot>::max();
+
+        Slot Find(const Key& key) const {
+            const auto it = m_keyToIndex.find(key);
+            return it != m_keyToIndex.end() ? it->second : InvalidSlot;
+        }
+
+        bool Contains(const Key& key) const { return m_keyToIndex.contains(key); }
+
+        void Set(const Key& key, const std::size_t slot) { m_keyToIndex[key] = slot; }
+
+        void Erase(const Key& key) { m_keyToIndex.erase(key); }
+
+        void Clear() { m_keyToIndex.clear(); }
+
+    private:
+        std::unordered_map<Key, std::size_t> m_keyToIndex; // Maps keys to their index in the dense array
+    };
+
+    // Index used by DenseMap unless one is given explicitly
+    template <typename Key>
+    using DefaultIndex = std::conditional_t<std::is_integral_v<Key>, SparseIndex<Key>, HashIndex<Key>>;
+
+    // Index for entity-keyed maps, addressed by slot index so generations do not spread the key range
+    using EntitySparseIndex = SparseIndex<Entity, EntityOffset>;
+
+} // namespace ecs
+
+#endif //SPARSEINDEX_HPP
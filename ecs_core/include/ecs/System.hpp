@@ -8,11 +8,20 @@
 #ifndef SYSTEM_HPP
 #define SYSTEM_HPP
 
+#include <chrono>
+#include <memory>
 #include "Types.hpp"
+#include "Debug.hpp"
 #include "DenseMap.hpp"
+#include "JobSystem.hpp"
+#include "PerThread.hpp"
+#include "SystemAccess.hpp"
+#include "SystemStats.hpp"
 
 namespace ecs {
 
+    class CommandBuffer;
+
     /**
      * @brief Base class for all ECS systems.
      *
@@ -22,7 +31,56 @@ namespace ecs {
     class System
     {
     protected:
-        DenseMap<Entity> m_entities;  // Set of entities this system operates on
+        EntityMap<>      m_entities;  // Set of entities this system operates on
+        SystemAccess     m_access;    // Data touched by Update, declared by the derived system for the Scheduler
+
+        /**
+         * @brief Calls a function for every entity of the system, split into chunks run in parallel.
+         *
+         * The entity set is cut into chunks of at least grain entities that
+         * start and end on cache-line boundaries of the set's packed array, and
+         * the chunks run on the Coordinator's JobSystem. Returns once every
+         * entity was visited. Results such as collision pairs or events should
+         * go to a PerThread buffer and be merged afterwards.
+         *
+         * The entity set must not change meanwhile, so the function must not add
+         * or remove components or destroy entities directly; record such changes
+         * into the thread's CommandBuffer instead: a function that also takes a
+         * CommandBuffer& is passed the buffer of the thread running the chunk,
+         * fetched once per chunk. Without a JobSystem (a system not registered
+         * through a Coordinator) the entities are visited in order on the calling
+         * thread.
+         * @code
+         * ParallelEach(256, [](Entity entity, CommandBuffer& commands)
+         * {
+         *     commands.DestroyEntity(entity);
+         * });
+         * @endcode
+         *
+         * @param grain Smallest number of entities per chunk; rounded up to whole cache lines.
+         * @param function Callable taking the Entity, or the Entity and a CommandBuffer&.
+         */
+        template<typename F>
+        void ParallelEach(std::size_t grain, F&& function);
+
+        /**
+         * @brief Calls a function for the entities of the system that fit into its time budget.
+         *
+         * Starts at the entity where the previous call stopped and continues in
+         * set order until the end of the set or until the time budget is used
+         * up, so expensive per-entity work is spread over several updates.
+         * Without a budget every remaining entity is visited. The clock is read
+         * every few entities, so a call may overrun the budget by a few calls of
+         * the function.
+         *
+         * The function must not change the entity set. Entities removed between
+         * calls can make the next call skip one entity of the current pass.
+         *
+         * @param function Callable taking the Entity.
+         * @return True if the call reached the end of the set, so the next call starts a new pass.
+         */
+        template<typename F>
+        bool EachSlice(F&& function);
 
     public:
         virtual ~System() = default;
@@ -51,8 +109,69 @@ namespace ecs {
          * @param entity The entity to remove.
          */
         void RemoveEntity(Entity entity);
+
+        /**
+         * @brief Removes every entity from this system.
+         */
+        void ClearEntities();
+
+        /**
+         * @brief Gets the data this system's Update reads and writes.
+         * @return The declared access; exclusive if the system declared nothing.
+         */
+        const SystemAccess& GetAccess() const { return m_access; }
+
+        /**
+         * @brief Calls Update if the system is due at its update rate.
+         *
+         * The time passed since Update last ran is accumulated, and Update gets
+         * all of it as its delta time, so timers in the system keep running at
+         * the real pace. The Scheduler calls this instead of Update. While
+         * statistics are enabled on the Coordinator, the update is recorded.
+         *
+         * @param dt Delta time since the previous call.
+         * @return True if Update ran.
+         */
+        bool UpdateIfDue(float dt);
+
+        /**
+         * @brief Limits how often UpdateIfDue runs Update.
+         * @param hz Updates per second; zero runs Update on every call.
+         */
+        void SetUpdateRate(float hz);
+
+        /**
+         * @brief Gets the update rate set with SetUpdateRate.
+         * @return Updates per second, or zero if Update runs on every call.
+         */
+        float GetUpdateRate() const;
+
+        /**
+         * @brief Sets the time EachSlice may spend per call.
+         * @param budget The budget; zero visits every entity.
+         */
+        void SetTimeBudget(std::chrono::nanoseconds budget) { m_timeBudget = budget; }
+
+        /**
+         * @brief Gets the time EachSlice may spend per call, zero if unlimited.
+         */
+        std::chrono::nanoseconds GetTimeBudget() const { return m_timeBudget; }
+
+    private:
+        friend class Coordinator;
+        friend class SystemManager;
+
+        JobSystem*               m_jobSystem = nullptr; // Runs ParallelEach chunks; set by Coordinator::RegisterSystem
+        PerThread<std::unique_ptr<CommandBuffer>>* m_commandBuffers = nullptr; // Buffers passed by ParallelEach; set by Coordinator::RegisterSystem
+        std::unique_ptr<SystemStatsRecorder> m_stats;   // Records updates while statistics are enabled; set by SystemManager
+        float                    m_updateInterval = 0.f; // Seconds between updates run by UpdateIfDue; zero for every call
+        float                    m_sinceUpdate = 0.f;   // Time passed since UpdateIfDue last ran Update
+        std::chrono::nanoseconds m_timeBudget {0};      // Time EachSlice may spend per call; zero for unlimited
+        std::size_t              m_cursor = 0;          // Position in the entity set where EachSlice resumes
     };
 
 } // namespace ecs
 
+#include "../src/System.tpp"
+
 #endif //SYSTEM_HPP
\ No newline at end of file
@@ -0,0 +1,150 @@
+/**
+ * @file SystemAccess.hpp
+ * @brief Declaration of the data a system touches while it updates.
+ *
+ * The Scheduler runs two systems at the same time only when their accesses do
+ * not conflict: neither writes a component type the other reads or writes, and
+ * neither dispatches events to the other's listeners. Component and event
+ * types are identified by their process-wide TypeIndex, so accesses can be
+ * declared before the types are registered with a Coordinator.
+ */
+#ifndef SYSTEMACCESS_HPP
+#define SYSTEMACCESS_HPP
+
+#include <cstddef>
+#include <vector>
+#include "TypeIndex.hpp"
+
+namespace ecs {
+
+    /**
+     * @brief Component and event types a system reads or writes.
+     *
+     * A system that declares nothing is treated as exclusive, so systems that
+     * were never annotated keep running alone.
+     *
+     * Adding or removing components and destroying entities through the
+     * Coordinator changes storage that every other system reads; systems that
+     * do so must be exclusive, or record the changes into their thread's
+     * CommandBuffer instead.
+     */
+    class SystemAccess
+    {
+    public:
+        /**
+         * @brief Declares component types the system only reads.
+         * @tparam Ts Component types.
+         * @return This access, for chaining.
+         */
+        template<typename... Ts>
+        SystemAccess& Read();
+
+        /**
+         * @brief Declares component types the system modifies.
+         * @tparam Ts Component types.
+         * @return This access, for chaining.
+         */
+        template<typename... Ts>
+        SystemAccess& Write();
+
+        /**
+         * @brief Declares event types the system queues on the EventBus.
+         *
+         * Workers queue into their own buffers of the EventBus, so emitters run
+         * in parallel; the buffers are merged in the order the systems were
+         * added, so the events' order does not depend on thread timing. The bus
+         * must have been given the scheduler's job system with
+         * EventBus::SetJobSystem.
+         *
+         * @tparam Es Event types.
+         * @return This access, for chaining.
+         */
+        template<typename... Es>
+        SystemAccess& Emit();
+
+        /**
+         * @brief Declares event types the system emits with fast set.
+         *
+         * Fast events are dispatched on the emitting thread, so the system does
+         * not run at the same time as systems that listen to them, nor as other
+         * systems emitting them fast, which would run the same listeners on two
+         * threads at once.
+         *
+         * @tparam Es Event types.
+         * @return This access, for chaining.
+         */
+        template<typename... Es>
+        SystemAccess& EmitFast();
+
+        /**
+         * @brief Declares event types the system's listeners handle.
+         *
+         * Queued events are dispatched by EventBus::ProcessEvents, outside any
+         * system, so this only orders the system against fast emitters.
+         *
+         * @tparam Es Event types.
+         * @return This access, for chaining.
+         */
+        template<typename... Es>
+        SystemAccess& Listen();
+
+        /**
+         * @brief Requires the system to run on the thread that calls Scheduler::Update.
+         *
+         * For systems that use thread-affine APIs, such as window input. It does
+         * not keep other systems from running at the same time.
+         *
+         * @return This access, for chaining.
+         */
+        SystemAccess& MainThread();
+
+        /**
+         * @brief Makes the system conflict with every other system.
+         *
+         * An exclusive system runs alone, on the thread that calls
+         * Scheduler::Update, after every system added before it and before every
+         * system added after it.
+         *
+         * @return This access, for chaining.
+         */
+        SystemAccess& Exclusive();
+
+        /**
+         * @brief Checks if the system runs alone, either declared so or by declaring nothing.
+         */
+        bool IsExclusive() const { return m_exclusive || !m_declared; }
+
+        /**
+         * @brief Checks if the system must run on the thread that calls Scheduler::Update.
+         */
+        bool IsMainThread() const { return m_mainThread || IsExclusive(); }
+
+        /**
+         * @brief Checks if two systems must not run at the same time.
+         * @param other The access of the other system.
+         * @return True if either system writes data the other reads or writes.
+         */
+        bool ConflictsWith(const SystemAccess& other) const;
+
+    private:
+        // Adds a type index to a sorted set
+        static void Insert(std::vector<std::size_t>& set, std::size_t index);
+
+        // Checks if two sorted sets share an element
+        static bool Intersects(const std::vector<std::size_t>& first, const std::vector<std::size_t>& second);
+
+        std::vector<std::size_t> m_reads;               // Component type indices read
+        std::vector<std::size_t> m_writes;              // Component type indices written
+        std::vector<std::size_t> m_emits;               // Event type indices queued; they do not conflict
+        std::vector<std::size_t> m_fastEmits;           // Event type indices dispatched immediately
+        std::vector<std::size_t> m_listens;             // Event type indices listened to
+        bool                     m_declared   = false;  // Whether anything was declared
+        bool                     m_exclusive  = false;  // Whether the system conflicts with every other system
+        bool                     m_mainThread = false;  // Whether the system must run on the updating thread
+    };
+
+} // namespace ecs
+
+#include "../src/SystemAccess.tpp"
+
+#endif //SYSTEMACCESS_HPP
@@ -4,17 +4,24 @@
  *
  * The SystemManager is responsible for registering systems, tracking which
  * components each system is interested in, and updating systems when entity
- * signatures change.
+ * signatures change. It indexes systems by component, so a signature change
+ * only tests the systems that require one of the components that changed.
  */
 #ifndef SYSTEMMANAGER_HPP
 #define SYSTEMMANAGER_HPP
 
+#include <array>
+#include <chrono>
+#include <limits>
 #include <memory>
-#include <unordered_map>
+#include <span>
 #include <string>
+#include <vector>
 #include "Types.hpp"
 #include "DenseMap.hpp"
 #include "System.hpp"
+#include "SystemStats.hpp"
+#include "TypeIndex.hpp"
 #include "Debug.hpp"
 
 namespace ecs {
@@ -37,6 +44,11 @@ namespace ecs {
 
         /**
          * @brief Sets which components a system is interested in.
+         *
+         * A system with an empty signature tracks no entities. Entities whose
+         * signatures already changed are not re-matched, so set signatures before
+         * adding components.
+         *
          * @tparam T The system type.
          * @param signature The component signature for the system.
          */
@@ -54,17 +66,102 @@ namespace ecs {
         /**
          * @brief Updates systems when an entity's signature changes.
          *
-         * This method is called when components are added to or removed from an entity.
-         * It updates which systems should process the entity based on its new signature.
+         * This method is called when components are added to or removed from an entity,
+         * and with an empty new signature when it is destroyed. Only the systems that
+         * require one of the components that changed are tested.
          *
          * @param entity The entity whose signature changed.
-         * @param entitySignature The entity's new signature.
+         * @param oldSignature The entity's signature before the change.
+         * @param newSignature The entity's new signature.
+         */
+        void EntitySignatureChanged(Entity entity, Signature oldSignature, Signature newSignature);
+
+        /**
+         * @brief Adds newly created entities that share one signature to the matching systems.
+         *
+         * Matching is done once for the whole batch. The entities must not be
+         * tracked by any system yet.
+         *
+         * @param entities The new entities.
+         * @param entitySignature The signature of every one of them.
+         */
+        void EntitiesCreated(std::span<const Entity> entities, Signature entitySignature);
+
+        /**
+         * @brief Removes destroyed entities that shared one signature from the systems tracking them.
+         *
+         * Only the systems whose signature the entities matched are visited, each
+         * once for the whole batch.
+         *
+         * @param entities The destroyed entities.
+         * @param entitySignature The signature every one of them had.
+         */
+        void EntitiesDestroyed(std::span<const Entity> entities, Signature entitySignature);
+
+        /**
+         * @brief Removes every entity from every system.
          */
-        void EntitySignatureChanged(Entity entity, Signature entitySignature);
+        void Clear();
+
+        /**
+         * @brief Starts recording the updates of every system, including systems registered later.
+         *
+         * Restarts the statistics if they were already enabled.
+         *
+         * @param window Number of latest updates each system's statistics cover.
+         */
+        void EnableStats(std::size_t window);
+
+        /**
+         * @brief Stops recording updates and drops the statistics.
+         */
+        void DisableStats();
+
+        /**
+         * @brief Gets the statistics of every system, in registration order.
+         * @return The statistics; empty while statistics are disabled.
+         */
+        std::vector<SystemStats> GetStats() const;
+
+        /**
+         * @brief Sets the update time of a system above which the overrun callback is called.
+         * @tparam T The system type.
+         * @param budget The budget; zero for none.
+         */
+        template<typename T>
+        void SetBudget(std::chrono::nanoseconds budget);
+
+        /**
+         * @brief Sets the function called when a system's update exceeds its budget.
+         * @param callback The callback; empty for none.
+         */
+        void SetBudgetOverrunCallback(BudgetOverrunCallback callback);
 
     private:
-        std::unordered_map<const char*, std::shared_ptr<System>> m_systems;    // Maps from type name to system
-        std::unordered_map<const char*, Signature>     m_signatures;  // Maps from type name to signature
+        /**
+         * @brief Gets the slot a system type occupies in this manager.
+         * @tparam T The system type.
+         * @return The slot, or UnregisteredSlot if T is not registered.
+         */
+        template<typename T>
+        std::size_t GetSlot() const;
+
+        // Marks process-wide type indices that are not registered with this manager
+        static constexpr std::size_t UnregisteredSlot = std::numeric_limits<std::size_t>::max();
+
+        // Lists a system under every component of its signature
+        void IndexSystem(std::size_t slot, bool add);
+
+        std::vector<std::size_t>              m_slots;       // Maps from process-wide type index to slot
+        std::vector<std::shared_ptr<System>>  m_systems;     // Systems in registration order
+        std::vector<Signature>                m_signatures;  // Signature of the system in the same slot
+        std::vector<std::string>              m_names;       // Type name of the system in the same slot
+        std::vector<std::chrono::nanoseconds> m_budgets;     // Update time budget of the system in the same slot
+
+        std::size_t                           m_statsWindow = 0; // Updates covered by the statistics; zero while disabled
+        BudgetOverrunCallback                 m_onOverrun;       // Called by recorders when an update exceeds its budget
+
+        std::array<std::vector<std::size_t>, MaxComponents> m_interested; // Slots of the systems requiring each component type
     };
 
 } // namespace ecs
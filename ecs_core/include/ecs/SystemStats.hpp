@@ -0,0 +1,164 @@
+/**
+ * @file SystemStats.hpp
+ * @brief Optional timing and activity statistics of system updates.
+ *
+ * When statistics are enabled on a Coordinator, every system gets a recorder
+ * that times its updates and keeps the last few hundred samples, so the cost
+ * of each system can be read as a rolling mean and percentiles. While a
+ * system updates, its recorder is the calling thread's current recorder, and
+ * structural changes and events made on that thread are counted against it.
+ * With statistics disabled the only cost is a null check per update and per
+ * counted operation.
+ */
+#ifndef SYSTEMSTATS_HPP
+#define SYSTEMSTATS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ecs {
+
+    /**
+     * @brief Statistics of one system over its last updates.
+     */
+    struct SystemStats
+    {
+        std::string              name;                  // Type name of the system
+        std::size_t              updates = 0;           // Number of updates covered, at most the window size
+        std::chrono::nanoseconds mean {0};              // Mean update time
+        std::chrono::nanoseconds p50 {0};               // Median update time
+        std::chrono::nanoseconds p99 {0};               // 99th percentile update time
+        std::chrono::nanoseconds max {0};               // Longest update time
+        std::size_t              entities = 0;          // Entities of the system at its last update
+        std::uint64_t            structuralChanges = 0; // Entities created or destroyed and components added or removed in the covered updates
+        std::uint64_t            eventsEmitted = 0;     // Events emitted in the covered updates
+        std::chrono::nanoseconds budget {0};            // Update time budget; zero if none
+        std::uint64_t            overruns = 0;          // Updates over the budget since statistics were enabled
+    };
+
+    /**
+     * @brief Called after an update that took longer than the system's budget.
+     *
+     * Runs on the thread that updated the system, which may be a worker of
+     * the JobSystem, so it must be safe to call from several threads at once.
+     */
+    using BudgetOverrunCallback = std::function<void(const std::string& name, std::chrono::nanoseconds elapsed,
+                                                     std::chrono::nanoseconds budget)>;
+
+    /**
+     * @brief Times the updates of one system and counts what they do.
+     */
+    class SystemStatsRecorder
+    {
+    public:
+        /**
+         * @brief Creates a recorder with an empty window.
+         * @param name Type name of the system.
+         * @param window Number of updates the statistics cover; must be positive.
+         * @param onOverrun Callback for budget overruns. Must outlive the recorder; may be empty.
+         */
+        SystemStatsRecorder(std::string name, std::size_t window, const BudgetOverrunCallback& onOverrun);
+
+        /**
+         * @brief Starts timing an update and makes this the calling thread's current recorder.
+         */
+        void Begin();
+
+        /**
+         * @brief Stops timing the update started by Begin and stores its sample.
+         * @param entities Number of entities of the system.
+         */
+        void End(std::size_t entities);
+
+        /**
+         * @brief Computes the statistics of the updates in the window.
+         *
+         * Must not be called while the system updates.
+         *
+         * @return The statistics.
+         */
+        SystemStats GetStats() const;
+
+        /**
+         * @brief Sets the update time above which the overrun callback is called.
+         * @param budget The budget; zero for none.
+         */
+        void SetBudget(std::chrono::nanoseconds budget) { m_budget = budget; }
+
+        /**
+         * @brief Makes a recorder the calling thread's current one.
+         *
+         * Used to attribute work a system hands to other threads, such as the
+         * chunks of ParallelEach.
+         *
+         * @param recorder The recorder, or null for none.
+         * @return The previous current recorder, to restore afterwards.
+         */
+        static SystemStatsRecorder* Attribute(SystemStatsRecorder* recorder)
+        {
+            SystemStatsRecorder* const previous = s_current;
+            s_current = recorder;
+            return previous;
+        }
+
+        /**
+         * @brief Gets the calling thread's current recorder, null outside recorded updates.
+         */
+        static SystemStatsRecorder* GetCurrent() { return s_current; }
+
+        /**
+         * @brief Counts structural changes against the calling thread's current recorder, if any.
+         * @param count Number of changes.
+         */
+        static void CountStructuralChanges(const std::uint64_t count = 1)
+        {
+            if (SystemStatsRecorder* const recorder = s_current)
+            {
+                recorder->m_structuralChanges.fetch_add(count, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Counts an emitted event against the calling thread's current recorder, if any.
+         */
+        static void CountEvent()
+        {
+            if (SystemStatsRecorder* const recorder = s_current)
+            {
+                recorder->m_eventsEmitted.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+    private:
+        // Measurements of one update
+        struct Sample
+        {
+            std::chrono::nanoseconds duration;          // Update time
+            std::uint64_t            structuralChanges; // Structural changes counted during the update
+            std::uint64_t            eventsEmitted;     // Events counted during the update
+        };
+
+        inline static thread_local SystemStatsRecorder* s_current = nullptr; // Recorder of the update running on this thread
+
+        std::string                           m_name;              // Type name of the system
+        const BudgetOverrunCallback&          m_onOverrun;         // Called when an update exceeds the budget
+        std::chrono::nanoseconds              m_budget {0};        // Update time budget; zero for none
+        std::vector<Sample>                   m_samples;           // Ring of the latest samples
+        std::size_t                           m_next = 0;          // Ring position the next sample is written to
+        std::size_t                           m_count = 0;         // Number of valid samples
+        std::size_t                           m_entities = 0;      // Entities at the last update
+        std::uint64_t                         m_overruns = 0;      // Updates over the budget
+        std::chrono::steady_clock::time_point m_start;             // Start of the running update
+        SystemStatsRecorder*                  m_previous = nullptr; // Current recorder before Begin, restored by End
+        std::atomic<std::uint64_t>            m_structuralChanges {0}; // Counted since Begin, possibly from several threads
+        std::atomic<std::uint64_t>            m_eventsEmitted {0};     // Counted since Begin, possibly from several threads
+    };
+
+} // namespace ecs
+
+#endif //SYSTEMSTATS_HPP
@@ -0,0 +1,193 @@
+/**
+ * @file Tracer.hpp
+ * @brief Scoped-zone timeline tracer with Chrome Trace Event export.
+ *
+ * An ECS_ZONE("name") marker times the rest of its scope. While the tracer
+ * records, each finished zone is written to a ring buffer owned by the thread
+ * it ran on, without locks, so zones are cheap enough to leave in shipping
+ * builds; while it does not record, a zone costs one atomic load. The
+ * recorded zones are written as Chrome Trace Event JSON, which Perfetto and
+ * chrome://tracing display as a per-thread timeline.
+ *
+ * ecs_core places zones around every system update, EventBus::ProcessEvents,
+ * each listener call, Coordinator::DestroyQueuedEntities and
+ * Coordinator::PlaybackCommands. Building with SIMPLYECS_ENABLE_TRACING off
+ * compiles every zone out.
+ */
+#ifndef TRACER_HPP
+#define TRACER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+
+namespace ecs {
+
+    /**
+     * @brief Process-wide recorder of timed zones.
+     * @code
+     * // On a hotkey: record the next 120 frames
+     * ecs::Tracer::Start(120);
+     *
+     * // At the end of every frame
+     * if (ecs::Tracer::EndFrame())
+     * {
+     *     std::ofstream file("frames.json");
+     *     ecs::Tracer::WriteChromeTrace(file);
+     * }
+     * @endcode
+     */
+    class Tracer
+    {
+    public:
+        /**
+         * @brief Discards earlier zones and starts recording.
+         * @param frames Number of EndFrame calls after which recording stops; zero records until Stop.
+         */
+        static void Start(std::size_t frames = 0);
+
+        /**
+         * @brief Stops recording. Zones already recorded are kept for export.
+         */
+        static void Stop();
+
+        /**
+         * @brief Checks if zones are being recorded.
+         */
+        static bool IsRecording() { return s_recording.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Marks the end of a frame, stopping the recording once the frames given to Start have passed.
+         * @return True if this call stopped the recording, so the trace is ready to write.
+         */
+        static bool EndFrame();
+
+        /**
+         * @brief Writes the recorded zones as Chrome Trace Event JSON.
+         *
+         * Call once recording stopped and the zones open at that time have
+         * closed, for example after the frame. Each thread that recorded a zone
+         * appears as its own track; only its latest zones are kept if it
+         * recorded more than its buffer holds.
+         *
+         * @param out Stream to write to.
+         */
+        static void WriteChromeTrace(std::ostream& out);
+
+        /**
+         * @brief Names the calling thread's track in written traces.
+         * @param name The name.
+         */
+        static void SetThreadName(std::string name);
+
+        /**
+         * @brief Sets how many zones each thread keeps, from the next Start on.
+         * @param zones Zones per thread; rounded up to a power of two.
+         */
+        static void SetBufferCapacity(std::size_t zones);
+
+        /**
+         * @brief Stores a finished zone in the calling thread's buffer.
+         * @param name Zone name; must stay valid until the trace is written.
+         * @param typeName Whether name is a type name from std::type_info, demangled on export.
+         * @param begin Start time in nanoseconds of the steady clock.
+         * @param end End time in nanoseconds of the steady clock.
+         */
+        static void Record(const char* name, bool typeName, std::int64_t begin, std::int64_t end);
+
+        /**
+         * @brief Gets the steady clock time zones are stamped with.
+         * @return Nanoseconds since the clock's epoch.
+         */
+        static std::int64_t Now()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+    private:
+        inline static std::atomic<bool> s_recording {false}; // Whether zones are recorded
+    };
+
+    /**
+     * @brief Times its scope as a zone while the Tracer records. Created by ECS_ZONE.
+     */
+    class TraceZone
+    {
+    public:
+        /**
+         * @brief Opens a zone with a fixed name.
+         * @param name Zone name, normally a string literal; must stay valid until the trace is written.
+         */
+        explicit TraceZone(const char* name)
+        : m_name(Tracer::IsRecording() ? name : nullptr)
+        , m_typeName(false)
+        , m_begin(m_name ? Tracer::Now() : 0)
+        {
+        }
+
+        /**
+         * @brief Opens a zone named after a type, such as the dynamic type of a system.
+         * @param type The type.
+         */
+        explicit TraceZone(const std::type_info& type)
+        : m_name(Tracer::IsRecording() ? type.name() : nullptr)
+        , m_typeName(true)
+        , m_begin(m_name ? Tracer::Now() : 0)
+        {
+        }
+
+        /**
+         * @brief Opens a zone named after a type held in a std::type_index.
+         * @param type The type.
+         */
+        explicit TraceZone(const std::type_index type)
+        : m_name(Tracer::IsRecording() ? type.name() : nullptr)
+        , m_typeName(true)
+        , m_begin(m_name ? Tracer::Now() : 0)
+        {
+        }
+
+        /**
+         * @brief Closes the zone and records it if it was opened while recording.
+         */
+        ~TraceZone()
+        {
+            if (m_name)
+            {
+                Tracer::Record(m_name, m_typeName, m_begin, Tracer::Now());
+            }
+        }
+
+        TraceZone(const TraceZone&) = delete;
+        TraceZone& operator=(const TraceZone&) = delete;
+
+    private:
+        const char*  m_name;     // Zone name, null if the tracer was not recording when the zone opened
+        bool         m_typeName; // Whether m_name is a mangled type name
+        std::int64_t m_begin;    // Start time in nanoseconds
+    };
+
+} // namespace ecs
+
+#define ECS_ZONE_CONCAT_INNER(a, b) a##b
+#define ECS_ZONE_CONCAT(a, b) ECS_ZONE_CONCAT_INNER(a, b)
+
+#ifdef SIMPLYECS_NO_TRACING
+#define ECS_ZONE(name) ((void)0)
+#else
+/**
+ * @brief Records the rest of the enclosing scope as a zone named name while the Tracer records.
+ *
+ * name is a string that outlives the trace, such as a literal, or a std::type_info
+ * or std::type_index whose demangled name is used.
+ */
+#define ECS_ZONE(name) const ::ecs::TraceZone ECS_ZONE_CONCAT(ecsZone, __LINE__)(name)
+#endif
+
+#endif //TRACER_HPP
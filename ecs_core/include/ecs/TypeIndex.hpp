@@ -0,0 +1,47 @@
+/**
+ * @file TypeIndex.hpp
+ * @brief Process-wide sequential indices for C++ types.
+ *
+ * Each type gets a small integer the first time it is queried, which lets
+ * managers reach per-type data with a plain vector index instead of hashing
+ * type names. Indices are counted separately per family (components, systems,
+ * events).
+ */
+#ifndef TYPEINDEX_HPP
+#define TYPEINDEX_HPP
+
+#include <atomic>
+#include <cstddef>
+
+namespace ecs {
+
+    struct ComponentFamily; // Index family for component types
+    struct SystemFamily;    // Index family for system types
+    struct EventFamily;     // Index family for event types
+
+    /**
+     * @brief Hands out sequential indices to types within a family.
+     * @tparam Family Tag type separating independent index spaces.
+     */
+    template<typename Family>
+    class TypeIndex
+    {
+    public:
+        /**
+         * @brief Gets the index of a type, assigning one on first use.
+         * @tparam T The type to look up.
+         * @return The index of T within this family.
+         */
+        template<typename T>
+        static std::size_t Get() {
+            static const std::size_t index = s_nextIndex.fetch_add(1, std::memory_order_relaxed);
+            return index;
+        }
+
+    private:
+        static inline std::atomic<std::size_t> s_nextIndex {0}; // Next index to hand out
+    };
+
+} // namespace ecs
+
+#endif //TYPEINDEX_HPP
@@ -12,24 +12,82 @@
 #include <cstdint>
 #include <cstddef>
 #include <limits>
+#include <type_traits>
 
 namespace ecs
 {
     using ComponentTypeID = std::size_t;  // Unique identifier for component types
     using ListenerID = std::size_t;       // Unique identifier for event listeners
-    using Entity = std::uint32_t;         // Entity identifier type
+
+    /**
+     * Entity handle. The low EntityIndexBits select a slot that is recycled after
+     * the entity is destroyed; the remaining high bits hold the slot's generation,
+     * which is bumped on every destruction so that old handles to a recycled slot
+     * no longer compare equal to the live one.
+     */
+    using Entity = std::uint32_t;
+
+    constexpr std::uint32_t EntityIndexBits      = 20;
+    constexpr std::uint32_t EntityGenerationBits = 32 - EntityIndexBits;
+    constexpr Entity        EntityIndexMask      = (Entity(1) << EntityIndexBits) - 1;
+    constexpr Entity        EntityGenerationMask = (Entity(1) << EntityGenerationBits) - 1;
 
     // Special entity value representing an invalid or null entity
     constexpr Entity NullEntity = std::numeric_limits<std::uint32_t>::max();
 
-    // Maximum number of entities that can exist simultaneously
-    constexpr std::size_t MaxEntities = 5000;
+    // Largest number of entities that can exist simultaneously; the default capacity of Coordinator::Init.
+    // The last index is reserved for NullEntity.
+    constexpr std::size_t MaxEntities = EntityIndexMask;
+
+    // Assumed size of a cache line. Data written by different threads is kept this far apart to avoid false sharing.
+    constexpr std::size_t CacheLineSize = 64;
+
+    /**
+     * @brief Gets the recyclable slot index of an entity.
+     */
+    constexpr std::uint32_t GetEntityIndex(const Entity entity) {
+        return entity & EntityIndexMask;
+    }
+
+    /**
+     * @brief Gets the generation of an entity's slot at the time the handle was created.
+     */
+    constexpr std::uint32_t GetEntityGeneration(const Entity entity) {
+        return entity >> EntityIndexBits;
+    }
+
+    /**
+     * @brief Builds an entity handle from a slot index and a generation.
+     */
+    constexpr Entity MakeEntity(const std::uint32_t index, const std::uint32_t generation) {
+        return (index & EntityIndexMask) | ((generation & EntityGenerationMask) << EntityIndexBits);
+    }
 
     // Maximum number of different component types
     constexpr std::size_t MaxComponents = 32;
 
+    // Signatures are walked bit by bit through Signature::to_ullong
+    static_assert(MaxComponents <= 64, "MaxComponents must fit in an unsigned long long");
+
     // Bitset representing which components an entity has
     using Signature = std::bitset<MaxComponents>;
+
+    /**
+     * @brief True if a component type is a tag.
+     *
+     * Tags are empty types. They have no storage at all and exist only as their
+     * bit in the entity's signature, so adding, removing and testing them never
+     * touches a component array.
+     */
+    template<typename T>
+    inline constexpr bool IsTag = std::is_empty_v<T>;
+
+    // How a Coordinator stores components
+    enum class StorageMode
+    {
+        Sparse,    // One packed array per component type (ComponentArray)
+        Archetype  // Entities grouped by signature in chunks with one column per component (ArchetypeStorage)
+    };
 }
 
 #endif //TYPES_HPP
\ No newline at end of file
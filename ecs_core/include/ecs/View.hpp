@@ -0,0 +1,202 @@
+/**
+ * @file View.hpp
+ * @brief Iteration over all entities that have a given set of components.
+ *
+ * With sparse storage a View walks the packed entity list of the smallest of its
+ * component arrays and resolves the remaining components through their sparse
+ * indices, so the cost is proportional to the rarest component rather than to
+ * every entity a system tracks. With archetype storage it walks the chunks of
+ * every archetype that has all of the components, column by column. Components
+ * are handed out by reference without going through the Coordinator.
+ *
+ * Tags can be required on top of the viewed components. With sparse storage they
+ * are tested against the entity's signature; with archetype storage they simply
+ * narrow down the matching archetypes.
+ */
+#ifndef VIEW_HPP
+#define VIEW_HPP
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "ArchetypeStorage.hpp"
+#include "ComponentManager.hpp"
+#include "EntityManager.hpp"
+#include "Types.hpp"
+
+namespace ecs {
+
+    /**
+     * @brief Non-owning view over the entities that have all of the given components.
+     *
+     * Components of the viewed types must not be added or removed while the view
+     * is being iterated; destroying entities through the Coordinator is fine since
+     * destruction is deferred.
+     *
+     * @tparam Ts The component types an entity must have.
+     */
+    template<typename... Ts>
+    class View
+    {
+        static_assert(sizeof...(Ts) > 0, "View requires at least one component type");
+        static_assert((... && !IsSoA<Ts>), "Views cannot hand out SoA components by reference");
+        static_assert((... && !IsTag<Ts>), "Views filter on tags, see ViewOf");
+
+    public:
+        /**
+         * @brief Creates a view over the given component arrays.
+         *
+         * The smallest array is picked here, so views are meant to be created
+         * right before they are iterated rather than kept across frames.
+         *
+         * @param entityManager Source of entity signatures for the tag test.
+         * @param tags Tags every visited entity must also have.
+         * @param arrays The storage of each component type, in the order of Ts.
+         */
+        View(const EntityManager& entityManager, Signature tags, ComponentArray<Ts>&... arrays);
+
+        /**
+         * @brief Creates a view over the archetypes that have every component.
+         *
+         * Matching archetypes are collected here, so entities moved into a newly
+         * created archetype afterwards are not visited.
+         *
+         * @param storage The archetype storage.
+         * @param types The component type ID of each of Ts.
+         * @param tags Tags every visited entity must also have.
+         */
+        View(const ArchetypeStorage& storage, const std::array<ComponentTypeID, sizeof...(Ts)>& types,
+             Signature tags = Signature());
+
+        /**
+         * @brief Calls a function for every entity that has all components.
+         *
+         * With sparse storage the loop is instantiated once per component type so
+         * that the driving pool's components are read straight from its packed
+         * storage. With archetype storage every component is read from its chunk
+         * column without lookups.
+         *
+         * @param func Callable as func(Entity, Ts&...).
+         */
+        template<typename Func>
+        void Each(Func&& func);
+
+        /**
+         * @brief Gets the number of entities the view will visit at most.
+         * @return Size of the smallest component array, or the exact number of
+         *         entities in the matching archetypes.
+         */
+        std::size_t SizeHint() const;
+
+        // Value produced by the iterator; bind with auto [entity, a, b] = ...
+        using Value = std::tuple<Entity, Ts&...>;
+
+        // Forward iterator over the matching entities of the smallest pool
+        class Iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using difference_type   = std::ptrdiff_t;
+            using value_type        = Value;
+            using pointer           = void;
+            using reference         = Value;
+
+            Iterator(View* view, std::size_t archetype, std::size_t index);
+
+            Iterator& operator++();
+            Iterator operator++(int) { Iterator temp = *this; ++(*this); return temp; }
+
+            bool operator==(const Iterator& other) const {
+                return (m_view == other.m_view) && (m_archetype == other.m_archetype) && (m_index == other.m_index);
+            }
+
+            bool operator!=(const Iterator& other) const {
+                return !(*this == other);
+            }
+
+            Value operator*() const;
+
+        private:
+            // Moves forward until the current entity has every component, resolving them on the way
+            void SkipMismatches();
+
+            View*              m_view;       // The view being iterated
+            std::size_t        m_archetype;  // Current matching archetype (archetype storage only)
+            std::size_t        m_index;      // Current index in the driving entity list, or row in the archetype
+            Entity             m_entity;     // The current entity
+            std::tuple<Ts*...> m_components; // Components of the current entity
+        };
+
+        /**
+         * @brief Returns an iterator to the first matching entity.
+         */
+        Iterator begin() { return Iterator(this, 0, 0); }
+
+        /**
+         * @brief Returns an iterator past the last matching entity.
+         */
+        Iterator end() {
+            return m_entities ? Iterator(this, 0, m_entities->size()) : Iterator(this, m_archetypes.size(), 0);
+        }
+
+    private:
+        template<typename Func, std::size_t... Is>
+        void EachDispatch(Func& func, std::index_sequence<Is...>);
+
+        template<std::size_t Driver, typename Func, std::size_t... Is>
+        void EachFrom(Func& func, std::index_sequence<Is...>);
+
+        template<typename Func, std::size_t... Is>
+        void EachChunk(Func& func, std::index_sequence<Is...>);
+
+        template<std::size_t... Is>
+        void ResolveRow(Archetype& archetype, std::size_t row, std::tuple<Ts*...>& components,
+                        std::index_sequence<Is...>) const;
+
+        // Looks up every viewed component of an entity; returns false if any is missing
+        bool Resolve(Entity entity, std::tuple<Ts*...>& components) const;
+
+        // Checks that an entity has every required tag (sparse storage only)
+        bool HasTags(Entity entity) const;
+
+        std::tuple<ComponentArray<Ts>*...>           m_arrays;     // Storage of each viewed component type
+        const EntityManager*                         m_signatures; // Signature source for the tag test (sparse storage only)
+        Signature                                    m_tags;       // Required tags (sparse storage only)
+        std::size_t                                  m_driver;     // Position in Ts of the smallest array
+        const std::vector<Entity>*                   m_entities;   // Packed entity list of the smallest array; null with archetypes
+        std::array<ComponentTypeID, sizeof...(Ts)>   m_types;      // Component type ID of each of Ts (archetype storage only)
+        std::vector<Archetype*>                      m_archetypes; // Archetypes that have every component (archetype storage only)
+    };
+
+    namespace Detail {
+        // Collects the non-tag types of a pack into a View
+        template<typename Components, typename... Ts>
+        struct ViewOf;
+
+        template<typename... Cs>
+        struct ViewOf<std::tuple<Cs...>>
+        {
+            using Type = View<Cs...>;
+        };
+
+        template<typename... Cs, typename T, typename... Ts>
+        struct ViewOf<std::tuple<Cs...>, T, Ts...>
+            : std::conditional_t<IsTag<T>, ViewOf<std::tuple<Cs...>, Ts...>, ViewOf<std::tuple<Cs..., T>, Ts...>>
+        {
+        };
+    } // namespace Detail
+
+    /**
+     * @brief The View that Coordinator::View<Ts...> returns: over the non-tag types of Ts, in order.
+     */
+    template<typename... Ts>
+    using ViewOf = typename Detail::ViewOf<std::tuple<>, Ts...>::Type;
+
+} // namespace ecs
+
+#include "../src/View.tpp"
+
+#endif //VIEW_HPP
@@ -0,0 +1,330 @@
+/**
+* @file ArchetypeStorage.cpp
+ * @brief Implementation of the Archetype and ArchetypeStorage classes.
+ */
+#include <ecs/ArchetypeStorage.hpp>
+#include <algorithm>
+
+namespace ecs {
+
+    // Archetype
+    Archetype::Archetype(const Signature signature, const std::vector<ComponentInfo>& infos)
+    : m_signature(signature)
+    , m_chunkCapacity(0)
+    , m_size(0)
+    {
+        m_columnIndices.fill(NoColumn);
+        m_addEdges.fill(nullptr);
+        m_removeEdges.fill(nullptr);
+
+        std::size_t rowSize = sizeof(Entity);
+        for (ComponentTypeID type = 0; type < MaxComponents; ++type)
+        {
+            if (!signature.test(type))
+            {
+                continue;
+            }
+
+            Debug::Assert(type < infos.size() && infos[type].alignment > 0,
+                "Archetype::Archetype - Component type is not registered with the archetype storage: %zu",
+                type);
+
+            // Tags are part of the signature only
+            if (infos[type].size == 0)
+            {
+                continue;
+            }
+
+            m_columnIndices[type] = m_columns.size();
+            m_columns.push_back({type, 0, infos[type]});
+            rowSize += infos[type].size;
+        }
+
+        // Start from the unpadded estimate and shrink until the aligned columns fit in a chunk
+        for (m_chunkCapacity = ChunkSize / rowSize; m_chunkCapacity > 0; --m_chunkCapacity)
+        {
+            std::size_t offset = sizeof(Entity) * m_chunkCapacity;
+            for (Column& column : m_columns)
+            {
+                const std::size_t alignment = column.info.alignment;
+                offset        = (offset + alignment - 1) / alignment * alignment;
+                column.offset = offset;
+                offset       += column.info.size * m_chunkCapacity;
+            }
+
+            if (offset <= ChunkSize)
+            {
+                break;
+            }
+        }
+
+        Debug::Assert(m_chunkCapacity > 0,
+            "Archetype::Archetype - Components of one entity do not fit in a chunk");
+    }
+
+    Archetype::~Archetype()
+    {
+        for (std::size_t row = 0; row < m_size; ++row)
+        {
+            DestroyRow(row);
+        }
+    }
+
+    std::size_t Archetype::GetChunkSize(const std::size_t chunk) const
+    {
+        Debug::Assert(chunk < GetChunkCount(),
+            "Archetype::GetChunkSize - Chunk out of range: %zu", chunk);
+
+        return std::min(m_chunkCapacity, m_size - chunk * m_chunkCapacity);
+    }
+
+    const Entity* Archetype::GetEntities(const std::size_t chunk) const
+    {
+        Debug::Assert(chunk < GetChunkCount(),
+            "Archetype::GetEntities - Chunk out of range: %zu", chunk);
+
+        return std::launder(reinterpret_cast<const Entity*>(m_chunks[chunk]->data));
+    }
+
+    Entity Archetype::GetEntity(const std::size_t row) const
+    {
+        Debug::Assert(row < m_size,
+            "Archetype::GetEntity - Row out of range: %zu", row);
+
+        return *std::launder(reinterpret_cast<const Entity*>(Address(row, 0, sizeof(Entity))));
+    }
+
+    void* Archetype::GetComponent(const std::size_t row, const ComponentTypeID type)
+    {
+        Debug::Assert(row < m_size && type < MaxComponents && m_columnIndices[type] != NoColumn,
+            "Archetype::GetComponent - Invalid row or component: Row=%zu, Type=%zu", row, type);
+
+        const Column& column = m_columns[m_columnIndices[type]];
+        return Address(row, column.offset, column.info.size);
+    }
+
+    std::size_t Archetype::PushRow(const Entity entity)
+    {
+        if (m_size == m_chunks.size() * m_chunkCapacity)
+        {
+            m_chunks.emplace_back(new Chunk); // Left uninitialized, rows are constructed on use
+        }
+
+        const std::size_t row = m_size++;
+        new (Address(row, 0, sizeof(Entity))) Entity(entity);
+
+        return row;
+    }
+
+    Entity Archetype::RemoveRow(const std::size_t row)
+    {
+        Debug::Assert(row < m_size,
+            "Archetype::RemoveRow - Row out of range: %zu", row);
+
+        const std::size_t last  = m_size - 1;
+        Entity            moved = NullEntity;
+        if (row != last)
+        {
+            for (const Column& column : m_columns)
+            {
+                column.info.relocate(Address(row, column.offset, column.info.size),
+                                     Address(last, column.offset, column.info.size));
+            }
+
+            moved = GetEntity(last);
+            new (Address(row, 0, sizeof(Entity))) Entity(moved);
+        }
+
+        --m_size;
+        return moved;
+    }
+
+    void Archetype::DestroyRow(const std::size_t row)
+    {
+        for (const Column& column : m_columns)
+        {
+            column.info.destroy(Address(row, column.offset, column.info.size));
+        }
+    }
+
+    void Archetype::Clear()
+    {
+        for (std::size_t row = 0; row < m_size; ++row)
+        {
+            DestroyRow(row);
+        }
+
+        m_size = 0;
+    }
+
+    Archetype*& Archetype::Edge(const ComponentTypeID type, const bool add)
+    {
+        return add ? m_addEdges[type] : m_removeEdges[type];
+    }
+
+    std::byte* Archetype::Address(const std::size_t row, const std::size_t offset, const std::size_t size) const
+    {
+        return m_chunks[row / m_chunkCapacity]->data + offset + (row % m_chunkCapacity) * size;
+    }
+
+    // Archetype Storage
+    ArchetypeStorage::ArchetypeStorage()
+    : m_locations(Location{})
+    {
+    }
+
+    void ArchetypeStorage::PlaceEntity(const Entity entity, const Signature signature)
+    {
+        Location& location = m_locations.At(GetEntityIndex(entity));
+        if (location.archetype && location.archetype->GetSignature() == signature)
+        {
+            return;
+        }
+
+        MoveEntity(entity, location, GetOrCreateArchetype(signature));
+    }
+
+    void ArchetypeStorage::RemoveComponent(const Entity entity, const ComponentTypeID type)
+    {
+        Location& location = m_locations.At(GetEntityIndex(entity));
+        Debug::Assert(location.archetype && location.archetype->GetSignature().test(type),
+            "ArchetypeStorage::RemoveComponent - Component does not exist: Type=%zu, Entity=%u",
+            type, entity);
+
+        MoveEntity(entity, location, GetNeighbour(location.archetype, type, false));
+    }
+
+    bool ArchetypeStorage::HasComponent(const Entity entity, const ComponentTypeID type) const
+    {
+        const Location& location = m_locations.Get(GetEntityIndex(entity));
+
+        return location.archetype && location.archetype->GetSignature().test(type);
+    }
+
+    void ArchetypeStorage::EntityDestroyed(const Entity entity)
+    {
+        Location& location = m_locations.At(GetEntityIndex(entity));
+        if (!location.archetype)
+        {
+            return;
+        }
+
+        Archetype& archetype = *location.archetype;
+        const std::size_t row = location.row;
+        location = Location{};
+
+        archetype.DestroyRow(row);
+        RemoveRow(archetype, row);
+    }
+
+    void ArchetypeStorage::Clear()
+    {
+        for (const auto& archetype : m_archetypes)
+        {
+            for (std::size_t row = 0; row < archetype->Size(); ++row)
+            {
+                m_locations.At(GetEntityIndex(archetype->GetEntity(row))) = Location{};
+            }
+
+            archetype->Clear();
+        }
+    }
+
+    void ArchetypeStorage::GetMatchingArchetypes(const Signature signature, std::vector<Archetype*>& archetypes) const
+    {
+        for (const auto& archetype : m_archetypes)
+        {
+            if ((archetype->GetSignature() & signature) == signature)
+            {
+                archetypes.push_back(archetype.get());
+            }
+        }
+    }
+
+    Archetype* ArchetypeStorage::GetOrCreateArchetype(const Signature signature)
+    {
+        // Entities without components are not stored anywhere
+        if (signature.none())
+        {
+            return nullptr;
+        }
+
+        const auto it = m_bySignature.find(signature);
+        if (it != m_bySignature.end())
+        {
+            return it->second;
+        }
+
+        m_archetypes.push_back(std::make_unique<Archetype>(signature, m_componentInfos));
+        Archetype* archetype = m_archetypes.back().get();
+        m_bySignature.emplace(signature, archetype);
+
+        return archetype;
+    }
+
+    Archetype* ArchetypeStorage::GetNeighbour(Archetype* archetype, const ComponentTypeID type, const bool add)
+    {
+        if (!archetype)
+        {
+            return GetOrCreateArchetype(Signature().set(type, add));
+        }
+
+        Archetype*& edge = archetype->Edge(type, add);
+        if (!edge)
+        {
+            edge = GetOrCreateArchetype(Signature(archetype->GetSignature()).set(type, add));
+        }
+
+        return edge;
+    }
+
+    std::size_t ArchetypeStorage::MoveEntity(const Entity entity, Location& location, Archetype* target)
+    {
+        Archetype* source = location.archetype;
+        std::size_t row   = 0;
+        if (target)
+        {
+            row = target->PushRow(entity);
+        }
+
+        if (source)
+        {
+            // Carry over the components both archetypes share and destroy the rest
+            const Signature shared = target ? (source->GetSignature() & target->GetSignature()) : Signature();
+            for (ComponentTypeID type = 0; type < MaxComponents; ++type)
+            {
+                if (!source->GetSignature().test(type) || m_componentInfos[type].size == 0)
+                {
+                    continue;
+                }
+
+                void* component = source->GetComponent(location.row, type);
+                if (shared.test(type))
+                {
+                    m_componentInfos[type].relocate(target->GetComponent(row, type), component);
+                }
+                else
+                {
+                    m_componentInfos[type].destroy(component);
+                }
+            }
+
+            RemoveRow(*source, location.row);
+        }
+
+        location.archetype = target;
+        location.row       = static_cast<std::uint32_t>(row);
+
+        return row;
+    }
+
+    void ArchetypeStorage::RemoveRow(Archetype& archetype, const std::size_t row)
+    {
+        const Entity moved = archetype.RemoveRow(row);
+        if (moved != NullEntity)
+        {
+            m_locations.At(GetEntityIndex(moved)).row = static_cast<std::uint32_t>(row);
+        }
+    }
+
+} // namespace ecs
@@ -0,0 +1,93 @@
+/**
+ * @file ArchetypeStorage.tpp
+ * @brief Template implementation of ArchetypeStorage methods.
+ */
+#pragma once
+
+namespace ecs {
+
+    template<typename T>
+    ComponentInfo ComponentInfo::Of()
+    {
+        ComponentInfo info;
+        info.size      = IsTag<T> ? 0 : sizeof(T);
+        info.alignment = alignof(T);
+        info.relocate  = [](void* destination, void* source) {
+            T* from = static_cast<T*>(source);
+            new (destination) T(std::move(*from));
+            from->~T();
+        };
+        info.destroy   = [](void* component) {
+            static_cast<T*>(component)->~T();
+        };
+
+        return info;
+    }
+
+    template<typename T>
+    T* Archetype::GetColumn(const std::size_t chunk, const ComponentTypeID type)
+    {
+        Debug::Assert(m_signature.test(type),
+            "Archetype::GetColumn - Component is not part of the archetype: Type=%s",
+            typeid(T).name());
+
+        return std::launder(reinterpret_cast<T*>(m_chunks[chunk]->data + m_columns[m_columnIndices[type]].offset));
+    }
+
+    template<typename T>
+    void ArchetypeStorage::RegisterComponentType(const ComponentTypeID type)
+    {
+        Debug::Assert(alignof(T) <= Archetype::ChunkAlignment,
+            "ArchetypeStorage::RegisterComponentType - Alignment is too large: %s",
+            typeid(T).name());
+
+        if (type >= m_componentInfos.size())
+        {
+            m_componentInfos.resize(type + 1);
+        }
+
+        m_componentInfos[type] = ComponentInfo::Of<T>();
+    }
+
+    template<typename T>
+    void ArchetypeStorage::AddComponent(const Entity entity, const ComponentTypeID type, const T& component)
+    {
+        Location& location = m_locations.At(GetEntityIndex(entity));
+        Debug::Assert(!location.archetype || !location.archetype->GetSignature().test(type),
+            "ArchetypeStorage::AddComponent - Component already exists: Type=%s, Entity=%u",
+            typeid(T).name(), entity);
+
+        Archetype* target = GetNeighbour(location.archetype, type, true);
+        const std::size_t row = MoveEntity(entity, location, target);
+        if constexpr (!IsTag<T>)
+        {
+            new (target->GetComponent(row, type)) T(component);
+        }
+    }
+
+    template<typename T>
+    void ArchetypeStorage::ConstructComponent(const Entity entity, const ComponentTypeID type, const T& component)
+    {
+        const Location& location = m_locations.Get(GetEntityIndex(entity));
+        Debug::Assert(location.archetype && location.archetype->GetSignature().test(type),
+            "ArchetypeStorage::ConstructComponent - Entity was not placed with the component: Type=%s, Entity=%u",
+            typeid(T).name(), entity);
+
+        if constexpr (!IsTag<T>)
+        {
+            new (location.archetype->GetComponent(location.row, type)) T(component);
+        }
+    }
+
+    template<typename T>
+    T& ArchetypeStorage::GetComponent(const Entity entity, const ComponentTypeID type)
+    {
+        const Location& location = m_locations.Get(GetEntityIndex(entity));
+        Debug::Assert(location.archetype && location.archetype->GetSignature().test(type),
+            "ArchetypeStorage::GetComponent - Component does not exist: Type=%s, Entity=%u",
+            typeid(T).name(), entity);
+
+        return *std::launder(static_cast<T*>(location.archetype->GetComponent(location.row, type)));
+    }
+
+} // namespace ecs
@@ -0,0 +1,46 @@
+/**
+* @file CommandBuffer.cpp
+ * @brief Implementation of the CommandBuffer class.
+ */
+#include <ecs/CommandBuffer.hpp>
+
+namespace ecs {
+
+    CommandBuffer::CommandBuffer(Coordinator& coordinator)
+    : m_coordinator(coordinator)
+    , m_pendingCount(0)
+    {
+    }
+
+    CommandBuffer::~CommandBuffer() = default;
+
+    CommandBuffer::PendingEntity CommandBuffer::CreateEntity()
+    {
+        const PendingEntity entity {m_pendingCount++};
+        m_commands.push_back({entity.id, 0, 0, CommandKind::Create, true});
+        SystemStatsRecorder::CountStructuralChanges();
+
+        return entity;
+    }
+
+    void CommandBuffer::DestroyEntity(const Entity entity)
+    {
+        m_commands.push_back({entity, 0, 0, CommandKind::Destroy, false});
+        SystemStatsRecorder::CountStructuralChanges();
+    }
+
+    void CommandBuffer::Clear()
+    {
+        m_commands.clear();
+        for (PayloadPool& pool : m_payloads)
+        {
+            if (pool.values)
+            {
+                pool.values->Clear();
+            }
+        }
+
+        m_pendingCount = 0;
+    }
+
+} // namespace ecs
@@ -0,0 +1,57 @@
+/**
+ * @file CommandBuffer.tpp
+ * @brief Template implementation of CommandBuffer methods.
+ *
+ * Included at the end of Coordinator.hpp, since recording needs the complete Coordinator.
+ */
+#pragma once
+
+#include <memory>
+
+namespace ecs {
+
+    template<typename T>
+    void CommandBuffer::AddComponent(const Entity entity, const T& component)
+    {
+        RecordAdd<T>(entity, false, component);
+    }
+
+    template<typename T>
+    void CommandBuffer::AddComponent(const PendingEntity entity, const T& component)
+    {
+        Debug::Assert(entity.id < m_pendingCount,
+            "CommandBuffer::AddComponent - Pending entity was not created by this buffer: %u", entity.id);
+
+        RecordAdd<T>(entity.id, true, component);
+    }
+
+    template<typename T>
+    void CommandBuffer::RemoveComponent(const Entity entity)
+    {
+        m_commands.push_back({entity, m_coordinator.GetComponentTypeID<T>(), 0, CommandKind::Remove, false});
+        SystemStatsRecorder::CountStructuralChanges();
+    }
+
+    template<typename T>
+    void CommandBuffer::RecordAdd(const Entity entity, const bool pending, const T& component)
+    {
+        const ComponentTypeID type = m_coordinator.GetComponentTypeID<T>();
+        if (type >= m_payloads.size())
+        {
+            m_payloads.resize(type + 1);
+        }
+
+        PayloadPool& pool = m_payloads[type];
+        if (!pool.values)
+        {
+            pool.values = std::make_unique<Payloads<T>>();
+            pool.set    = &Coordinator::SetStoredComponent<T>;
+        }
+
+        auto& values = static_cast<Payloads<T>&>(*pool.values).values;
+        m_commands.push_back({entity, type, static_cast<std::uint32_t>(values.size()), CommandKind::Add, pending});
+        values.push_back(component);
+        SystemStatsRecorder::CountStructuralChanges();
+    }
+
+} // namespace ecs
@@ -3,6 +3,7 @@
  * @brief Implementation of the ComponentManager class.
  */
 #include <ecs/ComponentManager.hpp>
+#include <bit>
 
 namespace ecs {
     ComponentManager::ComponentManager()
@@ -10,15 +11,103 @@ namespace ecs {
     {
     }
 
-    void ComponentManager::EntityDestroyed(const Entity entity)
+    void ComponentManager::EntitiesDestroyed(const std::span<const Entity> entities, const Signature signature)
     {
-        for (auto const& [typeName, componentArray] : m_componentArrays)
+        for (auto bits = signature.to_ullong(); bits; bits &= bits - 1)
         {
-            if(componentArray->HasData(entity))
+            // Tags have no array to clean up
+            if (const auto& componentArray = m_componentArrays[std::countr_zero(bits)])
             {
-                componentArray->EntityDestroyed(entity);
+                componentArray->EntitiesDestroyed(entities);
             }
         }
     }
 
+    void ComponentManager::Clear()
+    {
+        for (const auto& componentArray : m_componentArrays)
+        {
+            if (componentArray)
+            {
+                componentArray->Clear();
+            }
+        }
+
+        for (const auto& group : m_groups)
+        {
+            group->Clear();
+        }
+    }
+
+    void ComponentManager::RemoveComponent(const Entity entity, const ComponentTypeID type)
+    {
+        Debug::Assert(type < m_componentArrays.size(),
+            "ComponentManager::RemoveComponent - Component type not registered: Type=%zu", type);
+
+        if (!m_componentArrays[type])
+        {
+            return;
+        }
+
+        Debug::Assert(m_componentArrays[type]->HasData(entity),
+            "ComponentManager::RemoveComponent - Component does not exist: Type=%zu, Entity=%u",
+            type, entity);
+
+        m_componentArrays[type]->RemoveData(entity);
+    }
+
+    // Group Storage
+    GroupStorage::GroupStorage(const Signature owned)
+    : m_owned(owned)
+    , m_size(0)
+    {
+    }
+
+    void GroupStorage::Own(IComponentArray& array)
+    {
+        Debug::Assert(m_size == 0,
+            "GroupStorage::Own - Arrays must be owned before entities enter the group");
+
+        m_arrays.push_back(&array);
+    }
+
+    void GroupStorage::OnInsert(const Entity entity)
+    {
+        for (IComponentArray* array : m_arrays)
+        {
+            if (!array->HasData(entity))
+            {
+                return;
+            }
+        }
+
+        // Already a member; every owned array agrees on its position
+        if (m_arrays.front()->IndexOf(entity) < m_size)
+        {
+            return;
+        }
+
+        for (IComponentArray* array : m_arrays)
+        {
+            array->MoveToIndex(entity, m_size);
+        }
+
+        ++m_size;
+    }
+
+    void GroupStorage::OnRemove(const Entity entity, IComponentArray& source)
+    {
+        // Non-members always sit behind the members, so one array is enough to tell
+        if (source.IndexOf(entity) >= m_size)
+        {
+            return;
+        }
+
+        --m_size;
+        for (IComponentArray* array : m_arrays)
+        {
+            array->MoveToIndex(entity, m_size);
+        }
+    }
+
 } // namespace ecs
\ No newline at end of file
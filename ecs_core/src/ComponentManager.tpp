@@ -4,7 +4,10 @@
  */
 #pragma once
 
+#include <array>
+#include <bit>
 #include <memory>
+#include <tuple>
 
 namespace ecs {
 
@@ -12,11 +15,21 @@ namespace ecs {
         void ComponentArray<T>::InsertData(const Entity entity, const T& component)
         {
             m_components.Insert(entity, component);
+
+            if (m_group)
+            {
+                m_group->OnInsert(entity);
+            }
         }
 
         template<typename T>
         void ComponentArray<T>::RemoveData(const Entity entity)
         {
+            if (m_group)
+            {
+                m_group->OnRemove(entity, *this);
+            }
+
             m_components.Erase(entity);
         }
 
@@ -33,91 +46,361 @@ namespace ecs {
         }
 
         template<typename T>
-        void ComponentArray<T>::EntityDestroyed(const Entity entity)
+        T* ComponentArray<T>::TryGetData(const Entity entity)
         {
-            m_components.Erase(entity);
-        };
+            return m_components.TryGetValue(entity);
+        }
+
+        template<typename T>
+        T& ComponentArray<T>::GetDataAt(const std::size_t index)
+        {
+            Debug::Assert(index < m_components.Size(),
+                "ComponentArray::GetDataAt - Index out of range: Type=%s, Index=%zu",
+                typeid(T).name(), index);
+
+            return m_components.GetDataVector()[index];
+        }
+
+        template<typename T>
+        const std::vector<Entity>& ComponentArray<T>::GetEntities() const
+        {
+            return m_components.GetKeyVector();
+        }
+
+        template<typename T>
+        std::size_t ComponentArray<T>::Size() const
+        {
+            return m_components.Size();
+        }
+
+        template<typename T>
+        void ComponentArray<T>::EntitiesDestroyed(const std::span<const Entity> entities)
+        {
+            for (const Entity entity : entities)
+            {
+                RemoveData(entity);
+            }
+        }
+
+        template<typename T>
+        void ComponentArray<T>::Clear()
+        {
+            m_components.Clear();
+        }
+
+        template<typename T>
+        std::size_t ComponentArray<T>::IndexOf(const Entity entity)
+        {
+            return m_components.IndexOf(entity);
+        }
+
+        template<typename T>
+        void ComponentArray<T>::MoveToIndex(const Entity entity, const std::size_t index)
+        {
+            m_components.Swap(entity, m_components.GetKeyVector()[index]);
+        }
+
+        template<typename T>
+        void ComponentArray<T>::SetGroup(GroupStorage* group)
+        {
+            m_group = group;
+        }
+
+        template<typename T>
+        GroupStorage* ComponentArray<T>::GetGroup() const
+        {
+            return m_group;
+        }
+
+        // SoA Component Array
+        template<typename T>
+        void SoAComponentArray<T>::InsertData(const Entity entity, const T& component)
+        {
+            Debug::Assert(!HasData(entity),
+                "SoAComponentArray::InsertData - Component already exists: Type=%s, Entity=%u",
+                typeid(T).name(), entity);
+
+            const auto lanes = std::bit_cast<std::array<float, LaneCount>>(component);
+
+            m_index.Set(entity, m_entities.size());
+            m_entities.push_back(entity);
+            for (std::size_t lane = 0; lane < LaneCount; ++lane)
+            {
+                m_columns[lane].push_back(lanes[lane]);
+            }
+        }
+
+        template<typename T>
+        void SoAComponentArray<T>::RemoveData(const Entity entity)
+        {
+            const std::size_t index = IndexOf(entity);
+            const std::size_t last  = m_entities.size() - 1;
+
+            // Swap and pop every column so they stay parallel to the entity list
+            const Entity moved = m_entities[last];
+            m_entities[index]  = moved;
+            for (std::vector<float>& column : m_columns)
+            {
+                column[index] = column[last];
+                column.pop_back();
+            }
+
+            m_index.Set(moved, index);
+            m_index.Erase(entity);
+            m_entities.pop_back();
+        }
+
+        template<typename T>
+        T SoAComponentArray<T>::GetData(const Entity entity) const
+        {
+            const auto index = m_index.Find(entity);
+            Debug::Assert(index != EntitySparseIndex::InvalidSlot && m_entities[index] == entity,
+                "SoAComponentArray::GetData - Component does not exist: Type=%s, Entity=%u",
+                typeid(T).name(), entity);
+
+            std::array<float, LaneCount> lanes;
+            for (std::size_t lane = 0; lane < LaneCount; ++lane)
+            {
+                lanes[lane] = m_columns[lane][index];
+            }
+
+            return std::bit_cast<T>(lanes);
+        }
+
+        template<typename T>
+        void SoAComponentArray<T>::SetData(const Entity entity, const T& component)
+        {
+            const std::size_t index = IndexOf(entity);
+
+            const auto lanes = std::bit_cast<std::array<float, LaneCount>>(component);
+            for (std::size_t lane = 0; lane < LaneCount; ++lane)
+            {
+                m_columns[lane][index] = lanes[lane];
+            }
+        }
+
+        template<typename T>
+        bool SoAComponentArray<T>::HasData(const Entity entity)
+        {
+            const auto index = m_index.Find(entity);
+            return index != EntitySparseIndex::InvalidSlot && m_entities[index] == entity;
+        }
+
+        template<typename T>
+        float* SoAComponentArray<T>::GetColumn(const std::size_t lane)
+        {
+            Debug::Assert(lane < LaneCount,
+                "SoAComponentArray::GetColumn - Lane out of range: Type=%s, Lane=%zu",
+                typeid(T).name(), lane);
+
+            return m_columns[lane].data();
+        }
+
+        template<typename T>
+        const std::vector<Entity>& SoAComponentArray<T>::GetEntities() const
+        {
+            return m_entities;
+        }
+
+        template<typename T>
+        std::size_t SoAComponentArray<T>::Size() const
+        {
+            return m_entities.size();
+        }
+
+        template<typename T>
+        void SoAComponentArray<T>::EntitiesDestroyed(const std::span<const Entity> entities)
+        {
+            for (const Entity entity : entities)
+            {
+                RemoveData(entity);
+            }
+        }
+
+        template<typename T>
+        void SoAComponentArray<T>::Clear()
+        {
+            for (const Entity entity : m_entities)
+            {
+                m_index.Erase(entity);
+            }
+
+            m_entities.clear();
+            for (std::vector<float>& column : m_columns)
+            {
+                column.clear();
+            }
+        }
+
+        template<typename T>
+        std::size_t SoAComponentArray<T>::IndexOf(const Entity entity)
+        {
+            Debug::Assert(HasData(entity),
+                "SoAComponentArray::IndexOf - Component does not exist: Type=%s, Entity=%u",
+                typeid(T).name(), entity);
+
+            return m_index.Find(entity);
+        }
+
+        template<typename T>
+        void SoAComponentArray<T>::MoveToIndex(const Entity entity, const std::size_t index)
+        {
+            const std::size_t from = IndexOf(entity);
+            if (from == index)
+            {
+                return;
+            }
+
+            std::swap(m_entities[from], m_entities[index]);
+            for (std::vector<float>& column : m_columns)
+            {
+                std::swap(column[from], column[index]);
+            }
+
+            m_index.Set(m_entities[from], from);
+            m_index.Set(m_entities[index], index);
+        }
 
         // Component Manager
         template<typename T>
         void ComponentManager::RegisterComponentType()
         {
-            Debug::Assert(m_nextComponentTypeID <= MaxComponents,
+            Debug::Assert(m_nextComponentTypeID < MaxComponents,
                 "ComponentManager::RegisterComponentType - Exceeded MAX_COMPONENTS limit: %zu",
                 MaxComponents);
 
-            const char* typeName = typeid(T).name();
-            Debug::Assert(!m_componentTypes.contains(typeName),
+            Debug::Assert(!IsRegistered<T>(),
                 "ComponentManager::RegisterComponentType - Registering component type more than once: %s",
-                typeName);
+                typeid(T).name());
+
+            const std::size_t typeIndex = TypeIndex<ComponentFamily>::Get<T>();
+            if (typeIndex >= m_componentTypes.size())
+            {
+                m_componentTypes.resize(typeIndex + 1, UnregisteredID);
+            }
 
-            // Assign a unique ID to this component type and create its storage
-            m_componentTypes[typeName] = m_nextComponentTypeID;
-            m_componentArrays[typeName] = std::make_shared<ComponentArray<T>>();
+            // Assign a unique ID to this component type and create its storage, if it has any
+            m_componentTypes[typeIndex] = m_nextComponentTypeID;
+            if constexpr (IsTag<T>)
+            {
+                m_componentArrays.emplace_back();
+            }
+            else
+            {
+                m_componentArrays.push_back(std::make_unique<ComponentStorage<T>>());
+            }
             ++m_nextComponentTypeID;
         }
 
         template<typename T>
         ComponentTypeID ComponentManager::GetComponentTypeID()
         {
-            const char* typeName = typeid(T).name();
-            Debug::Assert(m_componentTypes.contains(typeName),
+            Debug::Assert(IsRegistered<T>(),
                 "ComponentManager::GetComponentTypeID - Component type not registered: %s",
-                typeName);
+                typeid(T).name());
 
-            return m_componentTypes[typeName];
+            return m_componentTypes[TypeIndex<ComponentFamily>::Get<T>()];
         }
 
         template<typename T>
         void ComponentManager::AddComponent(Entity entity, const T& component)
         {
-            auto componentArray = GetComponentArray<T>();
-            Debug::Assert(!componentArray->HasData(entity),
+            auto& componentArray = GetComponentArray<T>();
+            Debug::Assert(!componentArray.HasData(entity),
                 "ComponentManager::AddComponent - Component already exists: Type=%s, Entity=%u",
                 typeid(T).name(), entity);
 
-            componentArray->InsertData(entity, component);
+            componentArray.InsertData(entity, component);
         }
 
         template<typename T>
         void ComponentManager::RemoveComponent(Entity entity)
         {
-            auto componentArray = GetComponentArray<T>();
-            Debug::Assert(componentArray->HasData(entity),
+            auto& componentArray = GetComponentArray<T>();
+            Debug::Assert(componentArray.HasData(entity),
                 "ComponentManager::RemoveComponent - Component does not exist: Type=%s, Entity=%u",
                 typeid(T).name(), entity);
 
-            componentArray->RemoveData(entity);
+            componentArray.RemoveData(entity);
         }
 
         template<typename T>
         T& ComponentManager::GetComponent(Entity entity)
         {
-            auto componentArray = GetComponentArray<T>();
-            Debug::Assert(componentArray->HasData(entity),
+            static_assert(!IsSoA<T>, "SoA components cannot be referenced");
+
+            auto& componentArray = GetComponentArray<T>();
+            Debug::Assert(componentArray.HasData(entity),
                 "ComponentManager::GetComponent - Component does not exist: Type=%s, Entity=%u",
                 typeid(T).name(), entity);
 
-            return componentArray->GetData(entity);
+            return componentArray.GetData(entity);
         }
 
         template<typename T>
         bool ComponentManager::HasComponent(Entity entity)
         {
-            auto componentArray = GetComponentArray<T>();
-
-            return componentArray->HasData(entity);
+            return GetComponentArray<T>().HasData(entity);
         }
 
         template<typename T>
-        std::shared_ptr<ComponentArray<T>> ComponentManager::GetComponentArray()
+        ComponentStorage<T>& ComponentManager::GetComponentArray()
         {
-            const char* typeName = typeid(T).name();
-            Debug::Assert(m_componentTypes.contains(typeName),
+            static_assert(!IsTag<T>, "Tag components have no storage, test the entity's signature instead");
+
+            Debug::Assert(IsRegistered<T>(),
                 "ComponentManager::GetComponentArray - Component type not registered: %s",
-                typeName);
+                typeid(T).name());
+
+            return static_cast<ComponentStorage<T>&>(*m_componentArrays[GetComponentTypeID<T>()]);
+        }
+
+        template<typename... Ts>
+        GroupStorage& ComponentManager::GetOrCreateGroup()
+        {
+            static_assert((... && !IsSoA<Ts>), "Groups cannot own SoA components");
+
+            Signature owned;
+            (owned.set(GetComponentTypeID<Ts>()), ...);
+
+            using First = std::tuple_element_t<0, std::tuple<Ts...>>;
+            if (GroupStorage* existing = GetComponentArray<First>().GetGroup())
+            {
+                Debug::Assert(existing->GetOwned() == owned,
+                    "ComponentManager::GetOrCreateGroup - Component type is already owned by another group: %s",
+                    typeid(First).name());
+
+                return *existing;
+            }
+
+            Debug::Assert((... && !GetComponentArray<Ts>().GetGroup()),
+                "ComponentManager::GetOrCreateGroup - Component type is already owned by another group");
+
+            m_groups.push_back(std::make_unique<GroupStorage>(owned));
+            GroupStorage& group = *m_groups.back();
+            (group.Own(GetComponentArray<Ts>()), ...);
+            (GetComponentArray<Ts>().SetGroup(&group), ...);
+
+            // Sort in the entities that already have every owned component, scanning the smallest array.
+            // Members are swapped towards the front, behind the scan position, so each entity is visited once.
+            const std::vector<Entity>* candidates = nullptr;
+            ((candidates = (!candidates || GetComponentArray<Ts>().Size() < candidates->size())
+                ? &GetComponentArray<Ts>().GetEntities() : candidates), ...);
+
+            for (std::size_t i = 0; i < candidates->size(); ++i)
+            {
+                group.OnInsert((*candidates)[i]);
+            }
+
+            return group;
+        }
+
+        template<typename T>
+        bool ComponentManager::IsRegistered() const
+        {
+            const std::size_t typeIndex = TypeIndex<ComponentFamily>::Get<T>();
 
-            return std::static_pointer_cast<ComponentArray<T>>(m_componentArrays[typeName]);
+            return typeIndex < m_componentTypes.size() && m_componentTypes[typeIndex] != UnregisteredID;
         }
 
 } // namespace ecs
\ No newline at end of file
@@ -3,14 +3,40 @@
  * @brief Implementation of the Coordinator class.
  */
 #include <ecs/Coordinator.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <memory>
+#include <utility>
+#include "ecs/Tracer.hpp"
 
 namespace ecs {
-    void Coordinator::Init()
+    void Coordinator::Init(const std::size_t maxEntities, const StorageMode storage, const std::size_t workerCount)
     {
-        m_entityManager    = std::make_unique<EntityManager>();
+        m_entityManager    = std::make_unique<EntityManager>(maxEntities);
         m_componentManager = std::make_unique<ComponentManager>();
         m_systemManager    = std::make_unique<SystemManager>();
+        m_archetypeStorage = storage == StorageMode::Archetype ? std::make_unique<ArchetypeStorage>() : nullptr;
+        m_jobSystem        = std::make_unique<JobSystem>(workerCount);
+
+        m_commandBuffers = std::make_unique<PerThread<std::unique_ptr<CommandBuffer>>>(*m_jobSystem);
+        m_commandBuffers->ForEach([this](std::unique_ptr<CommandBuffer>& buffer)
+        {
+            buffer = std::make_unique<CommandBuffer>(*this);
+        });
+    }
+
+    JobSystem& Coordinator::GetJobSystem()
+    {
+        Debug::Assert(!!m_jobSystem,
+            "Coordinator::GetJobSystem - JobSystem not initialized. Call Init() first");
+
+        return *m_jobSystem;
+    }
+
+    StorageMode Coordinator::GetStorageMode() const
+    {
+        return m_archetypeStorage ? StorageMode::Archetype : StorageMode::Sparse;
     }
 
     Entity Coordinator::CreateEntity()
@@ -18,14 +44,54 @@ namespace ecs {
         Debug::Assert(!!m_entityManager,
             "Coordinator::CreateEntity - EntityManager not initialized. Call Init() first");
 
+        SystemStatsRecorder::CountStructuralChanges();
         return m_entityManager->CreateEntity();
     }
 
+    Entity Coordinator::Instantiate(const Prefab& prefab)
+    {
+        const Entity entity = CreateEntity();
+        if (entity == NullEntity)
+        {
+            return NullEntity;
+        }
+
+        InstantiateComponents(prefab, std::span<const Entity>(&entity, 1));
+
+        return entity;
+    }
+
+    std::size_t Coordinator::Instantiate(const Prefab& prefab, const std::size_t count, std::vector<Entity>& entities)
+    {
+        Debug::Assert(!!m_entityManager,
+            "Coordinator::Instantiate - EntityManager not initialized. Call Init() first");
+
+        const std::size_t first = entities.size();
+        entities.reserve(first + count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const Entity entity = m_entityManager->CreateEntity();
+            if (entity == NullEntity)
+            {
+                break;
+            }
+
+            entities.push_back(entity);
+        }
+
+        const std::span<const Entity> created(entities.data() + first, entities.size() - first);
+        InstantiateComponents(prefab, created);
+        SystemStatsRecorder::CountStructuralChanges(created.size());
+
+        return created.size();
+    }
+
     void Coordinator::DestroyEntity(const Entity entity)
     {
         Debug::Assert(!!m_entityManager,
             "Coordinator::DestroyEntity - EntityManager not initialized. Call Init() first");
 
+        SystemStatsRecorder::CountStructuralChanges();
         m_entitiesToDestroy.push_back(entity);
     }
 
@@ -58,11 +124,16 @@ namespace ecs {
         Debug::Assert(m_entityManager && m_componentManager && m_systemManager,
             "Coordinator::DestroyQueuedEntities - Managers not initialized.");
 
+        ECS_ZONE("Coordinator::DestroyQueuedEntities");
+
         if(m_entitiesToDestroy.empty())
         {
             return;
         }
 
+        // Retire the handles first, which also drops entries queued twice, and group them by signature
+        std::size_t groupCount = 0;
+        std::size_t last       = 0;
         for (const auto e : m_entitiesToDestroy)
         {
             if (!m_entityManager->IsAlive(e))
@@ -70,28 +141,269 @@ namespace ecs {
                 continue;
             }
 
+            const Signature signature = m_entityManager->GetSignature(e);
             m_entityManager->DestroyEntity(e);
-            m_componentManager->EntityDestroyed(e);
-            m_systemManager->EntitySignatureChanged(e, Signature());
+
+            // Consecutive destructions usually share a signature, so try the last group first
+            if (last >= groupCount || m_destroyGroups[last].signature != signature)
+            {
+                last = 0;
+                while (last < groupCount && m_destroyGroups[last].signature != signature)
+                {
+                    ++last;
+                }
+
+                if (last == groupCount)
+                {
+                    if (groupCount == m_destroyGroups.size())
+                    {
+                        m_destroyGroups.emplace_back();
+                    }
+
+                    m_destroyGroups[groupCount].signature = signature;
+                    m_destroyGroups[groupCount].entities.clear();
+                    ++groupCount;
+                }
+            }
+
+            m_destroyGroups[last].entities.push_back(e);
         }
 
         m_entitiesToDestroy.clear();
+
+        // Each group visits only the arrays and systems of its signature, once
+        for (std::size_t group = 0; group < groupCount; ++group)
+        {
+            const DestroyGroup& destroyed = m_destroyGroups[group];
+            ComponentsDestroyed(destroyed.entities, destroyed.signature);
+            m_systemManager->EntitiesDestroyed(destroyed.entities, destroyed.signature);
+        }
     }
 
     void Coordinator::DestroyAllEntities()
     {
         Debug::Assert(m_entityManager && m_componentManager && m_systemManager,
-            "Coordinator::DestroyQueuedEntities - Managers not initialized.");
+            "Coordinator::DestroyAllEntities - Managers not initialized.");
+
+        m_commandBuffers->ForEach([](const std::unique_ptr<CommandBuffer>& buffer) { buffer->Clear(); });
 
         m_entitiesToDestroy.clear();
 
-        auto livingEntitiesCopy = m_entityManager->GetLivingEntities();
+        // Every store is emptied wholesale; nothing needs to be told about individual entities
+        if (m_archetypeStorage)
+        {
+            m_archetypeStorage->Clear();
+        }
+        m_componentManager->Clear();
+        m_systemManager->Clear();
+        m_entityManager->Clear();
+    }
 
-        for (auto const e : livingEntitiesCopy)
+    CommandBuffer& Coordinator::GetCommandBuffer()
+    {
+        Debug::Assert(!!m_commandBuffers,
+            "Coordinator::GetCommandBuffer - Managers not initialized. Call Init() first");
+
+        return *m_commandBuffers->Local();
+    }
+
+    void Coordinator::PlaybackCommands()
+    {
+        Debug::Assert(m_entityManager && m_componentManager && m_systemManager,
+            "Coordinator::PlaybackCommands - Managers not initialized.");
+
+        ECS_ZONE("Coordinator::PlaybackCommands");
+
+        // Buffers in thread index order, so the result does not depend on which thread recorded first
+        std::vector<Entity> created;
+        m_commandBuffers->ForEach([this, &created](const std::unique_ptr<CommandBuffer>& buffer)
         {
-            m_entityManager->DestroyEntity(e);
-            m_componentManager->EntityDestroyed(e);
-            m_systemManager->EntitySignatureChanged(e, Signature());
+            // Create the buffer's entities first so the other commands can refer to them
+            created.clear();
+            for (std::uint32_t i = 0; i < buffer->m_pendingCount; ++i)
+            {
+                created.push_back(m_entityManager->CreateEntity());
+            }
+
+            for (const CommandBuffer::Command& command : buffer->m_commands)
+            {
+                if (command.kind == CommandBuffer::CommandKind::Create)
+                {
+                    continue;
+                }
+
+                const Entity entity = command.pending ? created[command.entity] : command.entity;
+                if (entity != NullEntity)
+                {
+                    m_playback.push_back({entity, &command, buffer.get()});
+                }
+            }
+        });
+
+        // Group the commands by entity, keeping the recording order within each entity
+        const auto byEntity = [](const PlaybackCommand& a, const PlaybackCommand& b) { return a.entity < b.entity; };
+        if (!std::is_sorted(m_playback.begin(), m_playback.end(), byEntity))
+        {
+            std::stable_sort(m_playback.begin(), m_playback.end(), byEntity);
+        }
+
+        for (std::size_t first = 0; first < m_playback.size();)
+        {
+            std::size_t last = first + 1;
+            while (last < m_playback.size() && m_playback[last].entity == m_playback[first].entity)
+            {
+                ++last;
+            }
+
+            PlaybackEntityCommands(std::span<const PlaybackCommand>(m_playback.data() + first, last - first));
+            first = last;
+        }
+
+        m_playback.clear();
+        m_commandBuffers->ForEach([](const std::unique_ptr<CommandBuffer>& buffer) { buffer->Clear(); });
+
+        DestroyQueuedEntities();
+    }
+
+    void Coordinator::EnableSystemStats(const std::size_t window)
+    {
+        Debug::Assert(!!m_systemManager,
+            "Coordinator::EnableSystemStats - SystemManager not initialized. Call Init() first");
+
+        m_systemManager->EnableStats(window);
+    }
+
+    void Coordinator::DisableSystemStats()
+    {
+        Debug::Assert(!!m_systemManager,
+            "Coordinator::DisableSystemStats - SystemManager not initialized. Call Init() first");
+
+        m_systemManager->DisableStats();
+    }
+
+    std::vector<SystemStats> Coordinator::GetSystemStats() const
+    {
+        Debug::Assert(!!m_systemManager,
+            "Coordinator::GetSystemStats - SystemManager not initialized. Call Init() first");
+
+        return m_systemManager->GetStats();
+    }
+
+    void Coordinator::SetBudgetOverrunCallback(BudgetOverrunCallback callback)
+    {
+        Debug::Assert(!!m_systemManager,
+            "Coordinator::SetBudgetOverrunCallback - SystemManager not initialized. Call Init() first");
+
+        m_systemManager->SetBudgetOverrunCallback(std::move(callback));
+    }
+
+    void Coordinator::PlaybackEntityCommands(const std::span<const PlaybackCommand> commands)
+    {
+        const Entity entity = commands.front().entity;
+        if (!m_entityManager->IsAlive(entity))
+        {
+            return;
+        }
+
+        // Fold the commands into the final signature and the last value added for each type
+        const Signature current = m_entityManager->GetSignature(entity);
+        Signature target = current;
+        Signature assigned;
+        std::array<const PlaybackCommand*, MaxComponents> added;
+        for (const PlaybackCommand& playback : commands)
+        {
+            const CommandBuffer::Command& command = *playback.command;
+            switch (command.kind)
+            {
+                case CommandBuffer::CommandKind::Destroy:
+                    m_entitiesToDestroy.push_back(entity);
+                    return;
+                case CommandBuffer::CommandKind::Add:
+                    target.set(command.type);
+                    assigned.set(command.type);
+                    added[command.type] = &playback;
+                    break;
+                case CommandBuffer::CommandKind::Remove:
+                    target.reset(command.type);
+                    assigned.reset(command.type);
+                    break;
+                case CommandBuffer::CommandKind::Create:
+                    break;
+            }
+        }
+
+        if (m_archetypeStorage)
+        {
+            m_archetypeStorage->PlaceEntity(entity, target);
+        }
+        else
+        {
+            for (auto removed = (current & ~target).to_ullong(); removed; removed &= removed - 1)
+            {
+                m_componentManager->RemoveComponent(entity, std::countr_zero(removed));
+            }
+        }
+
+        for (auto bits = assigned.to_ullong(); bits; bits &= bits - 1)
+        {
+            const ComponentTypeID type = std::countr_zero(bits);
+            const CommandBuffer::Command& command = *added[type]->command;
+            const CommandBuffer::PayloadPool& pool = added[type]->buffer->m_payloads[type];
+            pool.set(*this, entity, pool.values->Get(command.payload), current.test(type));
+        }
+
+        if (target != current)
+        {
+            m_entityManager->SetSignature(entity, target);
+            m_systemManager->EntitySignatureChanged(entity, current, target);
+        }
+    }
+
+    void Coordinator::PlaceEntities(const std::span<const Entity> entities, const Signature signature)
+    {
+        if (!m_archetypeStorage)
+        {
+            return;
+        }
+
+        for (const Entity entity : entities)
+        {
+            m_archetypeStorage->PlaceEntity(entity, signature);
+        }
+    }
+
+    void Coordinator::PublishEntities(const std::span<const Entity> entities, const Signature signature)
+    {
+        for (const Entity entity : entities)
+        {
+            m_entityManager->SetSignature(entity, signature);
+        }
+
+        m_systemManager->EntitiesCreated(entities, signature);
+    }
+
+    void Coordinator::InstantiateComponents(const Prefab& prefab, const std::span<const Entity> entities)
+    {
+        PlaceEntities(entities, prefab.m_signature);
+        for (const Prefab::Entry& entry : prefab.m_entries)
+        {
+            entry.insert(*this, entities, entry.component.get());
+        }
+        PublishEntities(entities, prefab.m_signature);
+    }
+
+    void Coordinator::ComponentsDestroyed(const std::span<const Entity> entities, const Signature signature)
+    {
+        if (m_archetypeStorage)
+        {
+            for (const Entity entity : entities)
+            {
+                m_archetypeStorage->EntityDestroyed(entity);
+            }
+        }
+        else
+        {
+            m_componentManager->EntitiesDestroyed(entities, signature);
         }
     }
 
@@ -9,10 +9,55 @@
 
 namespace ecs
 {
+    template<typename... Ts>
+    Entity Coordinator::CreateEntityWith(const Ts&... components)
+    {
+        Signature signature;
+        (signature.set(m_componentManager->GetComponentTypeID<Ts>()), ...);
+        Debug::Assert(signature.count() == sizeof...(Ts),
+            "Coordinator::CreateEntityWith - Component types must be unique");
+
+        const Entity entity = CreateEntity();
+        if (entity == NullEntity)
+        {
+            return NullEntity;
+        }
+
+        const std::span<const Entity> entities(&entity, 1);
+        PlaceEntities(entities, signature);
+        (InsertComponents<Ts>(entities, components), ...);
+        PublishEntities(entities, signature);
+
+        return entity;
+    }
+
+    template<typename... Ts>
+    Prefab Coordinator::CreatePrefab(const Ts&... components)
+    {
+        Prefab prefab;
+        (prefab.m_signature.set(m_componentManager->GetComponentTypeID<Ts>()), ...);
+        Debug::Assert(prefab.m_signature.count() == sizeof...(Ts),
+            "Coordinator::CreatePrefab - Component types must be unique");
+
+        prefab.m_entries.reserve(sizeof...(Ts));
+        (prefab.m_entries.push_back(MakePrefabEntry<Ts>(components)), ...);
+
+        return prefab;
+    }
+
     template<typename T>
     void Coordinator::RegisterComponent()
     {
+        Debug::Assert(!IsSoA<T> || !m_archetypeStorage,
+            "Coordinator::RegisterComponent - SoA components require sparse storage: Type = %s",
+            typeid(T).name());
+
         m_componentManager->RegisterComponentType<T>();
+
+        if (m_archetypeStorage)
+        {
+            m_archetypeStorage->RegisterComponentType<T>(m_componentManager->GetComponentTypeID<T>());
+        }
     }
 
     template<typename T>
@@ -22,16 +67,27 @@ namespace ecs
             "Coordinator::AddComponent - Entity does not alive: Type = %s, Entity = %u",
             typeid(T).name(), entity);
 
-        // Add the component to the entity
-        m_componentManager->AddComponent<T>(entity, component);
+        const ComponentTypeID type = m_componentManager->GetComponentTypeID<T>();
+
+        // Add the component to the entity; tags only need the archetype move
+        if (m_archetypeStorage)
+        {
+            m_archetypeStorage->AddComponent<T>(entity, type, component);
+        }
+        else if constexpr (!IsTag<T>)
+        {
+            m_componentManager->AddComponent<T>(entity, component);
+        }
 
         // Update the entity's signature
-        auto signature = m_entityManager->GetSignature(entity);
-        signature.set(m_componentManager->GetComponentTypeID<T>(), true);
+        const Signature previous = m_entityManager->GetSignature(entity);
+        auto signature = previous;
+        signature.set(type, true);
         m_entityManager->SetSignature(entity, signature);
 
         // Notify systems about the signature change
-        m_systemManager->EntitySignatureChanged(entity, signature);
+        m_systemManager->EntitySignatureChanged(entity, previous, signature);
+        SystemStatsRecorder::CountStructuralChanges();
     }
 
     template<typename T>
@@ -41,25 +97,46 @@ namespace ecs
             "Coordinator::RemoveComponent - Entity does not alive: Type = %s, Entity = %u",
             typeid(T).name(), entity);
 
+        const ComponentTypeID type = m_componentManager->GetComponentTypeID<T>();
+
         // Remove the component from the entity
-        m_componentManager->RemoveComponent<T>(entity);
+        if (m_archetypeStorage)
+        {
+            m_archetypeStorage->RemoveComponent(entity, type);
+        }
+        else if constexpr (!IsTag<T>)
+        {
+            m_componentManager->RemoveComponent<T>(entity);
+        }
 
         // Update the entity's signature
-        auto signature = m_entityManager->GetSignature(entity);
-        signature.set(m_componentManager->GetComponentTypeID<T>(), false);
+        const Signature previous = m_entityManager->GetSignature(entity);
+        auto signature = previous;
+        signature.set(type, false);
         m_entityManager->SetSignature(entity, signature);
 
         // Notify systems about the signature change
-        m_systemManager->EntitySignatureChanged(entity, signature);
+        m_systemManager->EntitySignatureChanged(entity, previous, signature);
+        SystemStatsRecorder::CountStructuralChanges();
     }
 
     template<typename T>
     T& Coordinator::GetComponent(const Entity entity)
     {
+        static_assert(!IsSoA<T>,
+            "SoA components cannot be referenced, use GetComponentArray<T>().GetData/SetData or its columns");
+        static_assert(!IsTag<T>,
+            "Tag components have no data, use HasComponent");
+
         Debug::Assert(m_entityManager->IsAlive(entity),
             "Coordinator::GetComponent - Entity does not alive: Type = %s, Entity = %u",
             typeid(T).name(), entity);
 
+        if (m_archetypeStorage)
+        {
+            return m_archetypeStorage->GetComponent<T>(entity, m_componentManager->GetComponentTypeID<T>());
+        }
+
         return m_componentManager->GetComponent<T>(entity);
     }
 
@@ -72,17 +149,141 @@ namespace ecs
     template<typename T>
     bool Coordinator::HasComponent(const Entity entity)
     {
-        Debug::Assert(m_entityManager->IsAlive(entity),
-            "Coordinator::HasComponent - Entity does not alive: Type = %s, Entity = %u",
-            typeid(T).name(), entity);
+        if (!m_entityManager->IsAlive(entity))
+        {
+            return false;
+        }
+
+        if constexpr (IsTag<T>)
+        {
+            return m_entityManager->GetSignature(entity).test(m_componentManager->GetComponentTypeID<T>());
+        }
+        else if (m_archetypeStorage)
+        {
+            return m_archetypeStorage->HasComponent(entity, m_componentManager->GetComponentTypeID<T>());
+        }
+        else
+        {
+            return m_componentManager->HasComponent<T>(entity);
+        }
+    }
+
+    template<typename T>
+    ComponentStorage<T>& Coordinator::GetComponentArray()
+    {
+        Debug::Assert(!m_archetypeStorage,
+            "Coordinator::GetComponentArray - Not available with archetype storage: Type = %s",
+            typeid(T).name());
+
+        return m_componentManager->GetComponentArray<T>();
+    }
+
+    template<typename... Ts>
+    ViewOf<Ts...> Coordinator::View()
+    {
+        Signature tags;
+        ([&] {
+            if constexpr (IsTag<Ts>)
+            {
+                tags.set(m_componentManager->GetComponentTypeID<Ts>());
+            }
+        }(), ...);
 
-        return m_componentManager->HasComponent<T>(entity);
+        return MakeView(tags, static_cast<ViewOf<Ts...>*>(nullptr));
+    }
+
+    template<typename... Ts>
+    View<Ts...> Coordinator::MakeView(const Signature tags, ecs::View<Ts...>*)
+    {
+        if (m_archetypeStorage)
+        {
+            return ecs::View<Ts...>(*m_archetypeStorage, {m_componentManager->GetComponentTypeID<Ts>()...}, tags);
+        }
+
+        return ecs::View<Ts...>(*m_entityManager, tags, m_componentManager->GetComponentArray<Ts>()...);
+    }
+
+    template<typename... Ts>
+    Group<Ts...> Coordinator::Group()
+    {
+        Debug::Assert(!m_archetypeStorage,
+            "Coordinator::Group - Not available with archetype storage");
+
+        return ecs::Group<Ts...>(m_componentManager->GetOrCreateGroup<Ts...>(),
+                                 m_componentManager->GetComponentArray<Ts>()...);
+    }
+
+    template<typename T>
+    void Coordinator::InsertComponents(const std::span<const Entity> entities, const T& component)
+    {
+        // Tags are fully described by the signature
+        if constexpr (!IsTag<T>)
+        {
+            const ComponentTypeID type = m_componentManager->GetComponentTypeID<T>();
+            if (m_archetypeStorage)
+            {
+                for (const Entity entity : entities)
+                {
+                    m_archetypeStorage->ConstructComponent<T>(entity, type, component);
+                }
+
+                return;
+            }
+
+            auto& componentArray = m_componentManager->GetComponentArray<T>();
+            for (const Entity entity : entities)
+            {
+                componentArray.InsertData(entity, component);
+            }
+        }
+    }
+
+    template<typename T>
+    Prefab::Entry Coordinator::MakePrefabEntry(const T& component)
+    {
+        return Prefab::Entry {
+            TypeIndex<ComponentFamily>::Get<T>(),
+            {new T(component), [](void* value) { delete static_cast<T*>(value); }},
+            [](Coordinator& coordinator, const std::span<const Entity> entities, const void* value) {
+                coordinator.InsertComponents<T>(entities, *static_cast<const T*>(value));
+            }
+        };
+    }
+
+    template<typename T>
+    void Coordinator::SetStoredComponent(Coordinator& coordinator, const Entity entity, const void* component, const bool exists)
+    {
+        // Tags have no value to store
+        if constexpr (!IsTag<T>)
+        {
+            const T& value = *static_cast<const T*>(component);
+            if (!exists)
+            {
+                coordinator.InsertComponents<T>(std::span<const Entity>(&entity, 1), value);
+            }
+            else if constexpr (IsSoA<T>)
+            {
+                coordinator.m_componentManager->GetComponentArray<T>().SetData(entity, value);
+            }
+            else if (coordinator.m_archetypeStorage)
+            {
+                coordinator.m_archetypeStorage->GetComponent<T>(entity, coordinator.m_componentManager->GetComponentTypeID<T>()) = value;
+            }
+            else
+            {
+                coordinator.m_componentManager->GetComponent<T>(entity) = value;
+            }
+        }
     }
 
     template<typename T, typename ... Args>
     std::shared_ptr<T> Coordinator::RegisterSystem(Args&&... args)
     {
-        return m_systemManager->RegisterSystem<T>(std::forward<Args>(args)...);
+        std::shared_ptr<T> system = m_systemManager->RegisterSystem<T>(std::forward<Args>(args)...);
+        system->m_jobSystem = m_jobSystem.get();
+        system->m_commandBuffers = m_commandBuffers.get();
+
+        return system;
     }
 
     template<typename T>
@@ -97,4 +298,10 @@ namespace ecs
         return m_systemManager->GetSystem<T>();
     }
 
+    template<typename T>
+    void Coordinator::SetSystemBudget(const std::chrono::nanoseconds budget)
+    {
+        m_systemManager->SetBudget<T>(budget);
+    }
+
 } // namespace ecs
\ No newline at end of file
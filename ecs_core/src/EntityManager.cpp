@@ -7,38 +7,70 @@
 #include "ecs/Debug.hpp"
 
 namespace ecs {
-    EntityManager::EntityManager()
+    EntityManager::EntityManager(const std::size_t maxEntities)
+    : m_maxEntities(maxEntities)
+    , m_nextIndex(0)
+    , m_handles(DeadHandle)
     {
-        // Initialize entity IDs pool (0 to MAX_ENTITIES-1)
-        for (Entity e = 0; e < MaxEntities; ++e)
-        {
-            m_availableEntities.push(e);
-        }
+        Debug::Assert(maxEntities <= MaxEntities,
+            "EntityManager::EntityManager - Capacity exceeds MaxEntities: %zu",
+            maxEntities);
     }
 
     Entity EntityManager::CreateEntity()
     {
-        Debug::Assert(!m_availableEntities.empty(),
+        const bool hasCapacity = m_livingEntities.Size() < m_maxEntities;
+        Debug::Assert(hasCapacity,
             "EntityManager::CreateEntity - Maximum number of entities exceeded: %zu",
-            MaxEntities);
+            m_maxEntities);
 
-        const Entity id = m_availableEntities.front();
-        m_availableEntities.pop();
-        m_livingEntities.Insert(id);
+        if (!hasCapacity)
+        {
+            return NullEntity;
+        }
 
-        return id;
+        Entity entity;
+        if (!m_availableEntities.empty())
+        {
+            entity = m_availableEntities.front();
+            m_availableEntities.pop();
+        }
+        else
+        {
+            entity = MakeEntity(m_nextIndex++, 0);
+        }
+
+        m_handles.At(GetEntityIndex(entity)) = entity;
+        m_livingEntities.Insert(entity);
+
+        return entity;
     }
 
     void EntityManager::DestroyEntity(const Entity entity)
     {
-        Debug::Assert(m_livingEntities.Contains(entity),
+        Debug::Assert(IsAlive(entity),
             "EntityManager::DestroyEntity - Entity is not alive: %u",
             entity);
 
-        // Remove from living entities, reset signature, and recycle ID
+        // Remove from living entities, reset signature, and recycle the slot under the next generation
+        const std::uint32_t index = GetEntityIndex(entity);
         m_livingEntities.Erase(entity);
-        m_signatures[entity].reset();
-        m_availableEntities.push(entity);
+        m_handles.At(index) = DeadHandle;
+        m_signatures.At(index).reset();
+        m_availableEntities.push(MakeEntity(index, GetEntityGeneration(entity) + 1));
+    }
+
+    void EntityManager::Clear()
+    {
+        for (const Entity entity : m_livingEntities.GetDataVector())
+        {
+            const std::uint32_t index = GetEntityIndex(entity);
+            m_handles.At(index) = DeadHandle;
+            m_signatures.At(index).reset();
+            m_availableEntities.push(MakeEntity(index, GetEntityGeneration(entity) + 1));
+        }
+
+        m_livingEntities.Clear();
     }
 
     const EntityVec& EntityManager::GetLivingEntities() const
@@ -48,29 +80,30 @@ namespace ecs {
 
     bool EntityManager::IsAlive(const Entity entity) const
     {
-        Debug::Assert(entity < MaxEntities,
-            "EntityManager::IsAlive - Entity is not valid: %u",
-            entity);
-
-        return m_livingEntities.Contains(entity);
+        return m_handles.Get(GetEntityIndex(entity)) == entity;
     }
 
     void EntityManager::SetSignature(const Entity entity, const Signature signature)
     {
-        Debug::Assert(entity < MaxEntities,
+        Debug::Assert(GetEntityIndex(entity) < m_nextIndex,
             "EntityManager::SetSignature - Entity is not valid: %u",
             entity);
 
-        m_signatures[entity] = signature;
+        m_signatures.At(GetEntityIndex(entity)) = signature;
     }
 
     Signature EntityManager::GetSignature(const Entity entity) const
     {
-        Debug::Assert(entity < MaxEntities,
-            "EntityManager::SetSignature - Entity is not valid: %u",
+        Debug::Assert(GetEntityIndex(entity) < m_nextIndex,
+            "EntityManager::GetSignature - Entity is not valid: %u",
             entity);
 
-        return m_signatures[entity];
+        return m_signatures.Get(GetEntityIndex(entity));
+    }
+
+    std::size_t EntityManager::GetMaxEntities() const
+    {
+        return m_maxEntities;
     }
 
-} // namespace ecs
\ No newline at end of file
+} // namespace ecs
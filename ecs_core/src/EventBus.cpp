@@ -3,45 +3,189 @@
  * @brief Implementation of the EventBus class.
  */
 #include <ecs/EventBus.hpp>
+#include <algorithm>
+#include <thread>
 #include <utility>
+#include "ecs/Tracer.hpp"
 
 namespace ecs
 {
     EventBus::EventBus()
     : m_nextListenerID(1) // Start IDs from 1 (0 is reserved as invalid)
+    , m_jobs(nullptr)
+    , m_ownerThread(std::this_thread::get_id())
+    , m_parallelDispatch(false)
+    , m_processing(false)
     {
     }
 
-    void EventBus::ProcessEvents()
+    EventBus::~EventBus() = default;
+
+    void EventBus::SetJobSystem(JobSystem& jobs)
+    {
+        Debug::Assert(!m_processing,
+            "EventBus::SetJobSystem - Called from a listener while processing events");
+
+        MergeThreadQueues();
+        m_jobs = &jobs;
+        m_threadQueues = std::vector<ThreadQueue>(jobs.GetThreadCount());
+    }
+
+    void EventBus::SetParallelDispatch(const bool parallel)
+    {
+        Debug::Assert(!parallel || m_jobs,
+            "EventBus::SetParallelDispatch - Call SetJobSystem first");
+
+        m_parallelDispatch = parallel && m_jobs;
+    }
+
+    void EventBus::Enqueue(ChannelBase& channel, const std::size_t count)
     {
-        // Process events in a separate queue to allow for new events to be queued during processing
-        auto currentQueue = std::move(m_eventQueue);
-        m_eventQueue.clear(); // Clear the main queue
+        if (!channel.queued)
+        {
+            channel.queued = true;
+            m_queuedChannels.push_back(&channel);
+        }
 
-        for(const auto& eventItem : currentQueue)
+        // Extend the last run if it has the same type
+        if (!m_runs.empty() && m_runs.back().channel == &channel)
+        {
+            m_runs.back().count += count;
+        }
+        else
         {
-            ProcessEvent(eventItem);
+            m_runs.push_back({&channel, count});
         }
     }
 
-    void EventBus::UnsubscribeAll()
+    void EventBus::MergeThreadQueues()
     {
-        m_listeners.clear();
-        m_eventQueue.clear();
+        m_mergeRuns.clear();
+        for (const ThreadQueue& queue : m_threadQueues)
+        {
+            for (const ThreadRun& run : queue.runs)
+            {
+                m_mergeRuns.push_back(&run);
+            }
+        }
+
+        if (m_mergeRuns.empty())
+        {
+            return;
+        }
+
+        // Stable, so runs of one key keep their queued order; equal keys of different threads stay in thread index order
+        const auto byOrder = [](const ThreadRun* a, const ThreadRun* b) { return a->order < b->order; };
+        if (!std::is_sorted(m_mergeRuns.begin(), m_mergeRuns.end(), byOrder))
+        {
+            std::stable_sort(m_mergeRuns.begin(), m_mergeRuns.end(), byOrder);
+        }
+
+        for (const ThreadRun* run : m_mergeRuns)
+        {
+            run->channel->Merge(*this, run->first, run->count);
+        }
+        m_mergeRuns.clear();
+
+        for (ThreadQueue& queue : m_threadQueues)
+        {
+            for (const auto& channel : queue.channels)
+            {
+                if (channel)
+                {
+                    channel->Clear();
+                }
+            }
+            queue.runs.clear();
+        }
+    }
+
+    void EventBus::ProcessEvents()
+    {
+        ECS_ZONE("EventBus::ProcessEvents");
+
+        Debug::Assert(!m_processing,
+            "EventBus::ProcessEvents - Called from a listener while processing events");
+
+        m_ownerThread = std::this_thread::get_id();
+
+        // Buffered events follow the others, in order key order
+        MergeThreadQueues();
+
+        // Take the queued events, so that new events can be queued during processing for the next call
+        std::swap(m_runs, m_processingRuns);
+        std::swap(m_queuedChannels, m_processingChannels);
+        for (ChannelBase* channel : m_processingChannels)
+        {
+            channel->BeginProcessing();
+        }
+
+        m_processing = true;
+        if (m_parallelDispatch && m_processingChannels.size() > 1)
+        {
+            // Each type is one job; its events keep their order
+            m_jobs->ParallelFor(0, m_processingChannels.size(), 1, [this](const std::size_t begin, const std::size_t end)
+            {
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    m_processingChannels[i]->DispatchAll();
+                }
+            });
+        }
+        else
+        {
+            for (const Run& run : m_processingRuns)
+            {
+                run.channel->Dispatch(run.count);
+            }
+            for (ChannelBase* channel : m_processingChannels)
+            {
+                channel->DispatchBatch();
+            }
+        }
+        m_processing = false;
+
+        // Keep the storage of the dispatched events for the next call
+        for (ChannelBase* channel : m_processingChannels)
+        {
+            channel->EndProcessing();
+        }
+        m_processingRuns.clear();
+        m_processingChannels.clear();
+
+        // Listeners removed by other listeners or while workers dispatched fast events are erased now that nothing
+        // of any type is dispatched
+        for (const auto& channel : m_channels)
+        {
+            if (channel && channel->removed.load(std::memory_order_relaxed))
+            {
+                channel->EraseRemoved();
+            }
+        }
     }
 
-    void EventBus::ProcessEvent(const ItemEvent& item)
+    void EventBus::UnsubscribeAll()
     {
-        const auto it = m_listeners.find(item.type);
-        Debug::Assert(it != m_listeners.end(),
-            "EventBus::RemoveListener - No listener exist for this event type: %s",
-            item.type.name());
+        for (const auto& channel : m_channels)
+        {
+            if (channel)
+            {
+                channel->Clear();
+            }
+        }
+        m_runs.clear();
+        m_queuedChannels.clear();
 
-        // Call all registered listeners
-        auto listenersToCall = it->second;
-        for(auto &listener : listenersToCall)
+        for (ThreadQueue& queue : m_threadQueues)
         {
-            listener.callback(item.event);
+            for (const auto& channel : queue.channels)
+            {
+                if (channel)
+                {
+                    channel->Clear();
+                }
+            }
+            queue.runs.clear();
         }
     }
-}
\ No newline at end of file
+}
@@ -4,35 +4,342 @@
  */
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <functional>
-#include <any>
-#include <typeindex>
+#include <memory>
+#include <span>
+#include <thread>
+#include <typeinfo>
 #include <utility>
-#include <algorithm>
 #include <vector>
+#include "ecs/Tracer.hpp"
 
 namespace ecs {
 
+    namespace Detail {
+
+        // Extracts the decayed parameter type of a single-argument member function pointer
+        template<typename Method>
+        struct ListenerMethod;
+
+        template<typename T, typename R, typename Arg>
+        struct ListenerMethod<R (T::*)(Arg)>
+        {
+            using Event = std::decay_t<Arg>;
+        };
+
+        template<typename T, typename R, typename Arg>
+        struct ListenerMethod<R (T::*)(Arg) const>
+        {
+            using Event = std::decay_t<Arg>;
+        };
+
+    } // namespace Detail
+
+    template<typename EventType>
+    template<auto Method, typename T>
+    EventDelegate<EventType> EventDelegate<EventType>::Bind(T& instance)
+    {
+        EventDelegate delegate;
+        delegate.m_object = const_cast<void*>(static_cast<const void*>(&instance));
+        delegate.m_call = [](void* object, const EventType& event)
+        {
+            std::invoke(Method, *static_cast<T*>(object), event);
+        };
+
+        return delegate;
+    }
+
+    template<typename EventType>
+    template<auto Function>
+    EventDelegate<EventType> EventDelegate<EventType>::Bind()
+    {
+        EventDelegate delegate;
+        delegate.m_call = [](void*, const EventType& event)
+        {
+            std::invoke(Function, event);
+        };
+
+        return delegate;
+    }
+
+    template<typename EventType>
+    template<typename F>
+    EventDelegate<EventType> EventDelegate<EventType>::Bind(F& callable)
+    {
+        EventDelegate delegate;
+        delegate.m_object = const_cast<void*>(static_cast<const void*>(&callable));
+        delegate.m_call = [](void* object, const EventType& event)
+        {
+            std::invoke(*static_cast<F*>(object), event);
+        };
+
+        return delegate;
+    }
+
+    template<typename EventType>
+    struct EventBus::Channel final : ChannelBase
+    {
+        // A registered listener
+        struct Listener
+        {
+            ListenerID                                           id;       // Unique ID, zero once removed until ProcessEvents erases it
+            EventDelegate<EventType>                             delegate; // Called with each event
+            std::unique_ptr<std::function<void(const EventType&)>> owned;  // Function the delegate refers to, if the bus owns it
+        };
+
+        // A registered batch listener
+        struct BatchListener
+        {
+            ListenerID                                                       id;       // Unique ID, zero once removed until ProcessEvents erases it
+            std::unique_ptr<std::function<void(std::span<const EventType>)>> callback; // Called with the events; boxed so adding a listener keeps it in place
+        };
+
+        std::vector<Listener>      listeners;       // Listeners in registration order
+        std::vector<BatchListener> batchListeners;  // Batch listeners in registration order
+        std::vector<EventType>     pending;         // Events queued since the last ProcessEvents
+        std::vector<EventType>     processing;      // Events being dispatched by ProcessEvents
+        std::size_t                cursor = 0;      // Next event of processing to dispatch
+        std::atomic<std::size_t>   depth {0};       // Number of dispatches of this type in progress; fast events may be dispatched on several threads
+
+        // Checks if a listener is still registered. Its ID may be cleared by another thread dispatching fast events.
+        static bool IsActive(ListenerID& id)
+        {
+            return std::atomic_ref<ListenerID>(id).load(std::memory_order_relaxed) != 0;
+        }
+
+        // Marks a listener removed, so dispatches skip it until ProcessEvents erases it
+        void MarkRemoved(ListenerID& id)
+        {
+            std::atomic_ref<ListenerID>(id).store(0, std::memory_order_relaxed);
+            removed.store(true, std::memory_order_relaxed);
+        }
+
+        // Checks that an event of this type has someone to go to
+        void AssertListened() const
+        {
+            Debug::Assert(!listeners.empty() || !batchListeners.empty(),
+                "EventBus::ProcessEvent - No listener exist for this event type: %s",
+                typeid(EventType).name());
+        }
+
+        // Calls every listener with an event, within a dispatch
+        void CallListeners(const EventType& event)
+        {
+            // Listeners added by a listener get the next event; delegates are copied so adding may reallocate
+            const std::size_t count = listeners.size();
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (IsActive(listeners[i].id))
+                {
+                    const EventDelegate<EventType> delegate = listeners[i].delegate;
+                    ECS_ZONE(typeid(EventType));
+                    delegate(event);
+                }
+            }
+        }
+
+        // Calls every listener with an event
+        void DispatchEvent(const EventType& event)
+        {
+            AssertListened();
+            depth.fetch_add(1, std::memory_order_relaxed);
+            CallListeners(event);
+            EndDispatch();
+        }
+
+        // Calls every batch listener with a span of events
+        void DispatchBatch(const std::span<const EventType> events)
+        {
+            depth.fetch_add(1, std::memory_order_relaxed);
+            const std::size_t count = batchListeners.size();
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (IsActive(batchListeners[i].id))
+                {
+                    const auto* const callback = batchListeners[i].callback.get();
+                    ECS_ZONE(typeid(EventType));
+                    (*callback)(events);
+                }
+            }
+            EndDispatch();
+        }
+
+        // Ends a dispatch. Removed listeners are left to EraseRemoved, as fast events of this type may still be
+        // dispatched on other threads.
+        void EndDispatch()
+        {
+            depth.fetch_sub(1, std::memory_order_release);
+        }
+
+        void EraseRemoved() override
+        {
+            std::erase_if(listeners, [](const Listener& listener) { return listener.id == 0; });
+            std::erase_if(batchListeners, [](const BatchListener& listener) { return listener.id == 0; });
+            removed.store(false, std::memory_order_relaxed);
+        }
+
+        void BeginProcessing() override
+        {
+            std::swap(pending, processing);
+            cursor = 0;
+            queued = false;
+        }
+
+        void Dispatch(const std::size_t count) override
+        {
+            // Types with batch listeners only are left to DispatchBatch
+            if (listeners.empty() && !batchListeners.empty())
+            {
+                cursor += count;
+                return;
+            }
+
+            AssertListened();
+            depth.fetch_add(1, std::memory_order_relaxed);
+            for (const std::size_t end = cursor + count; cursor < end; ++cursor)
+            {
+                CallListeners(processing[cursor]);
+            }
+            EndDispatch();
+        }
+
+        void DispatchBatch() override
+        {
+            if (!batchListeners.empty())
+            {
+                DispatchBatch(processing);
+            }
+        }
+
+        void DispatchAll() override
+        {
+            Dispatch(processing.size() - cursor);
+            DispatchBatch();
+        }
+
+        void EndProcessing() override
+        {
+            processing.clear();
+        }
+
+        void Clear() override
+        {
+            pending.clear();
+            queued = false;
+            if (depth.load(std::memory_order_acquire) == 0)
+            {
+                listeners.clear();
+                batchListeners.clear();
+                removed.store(false, std::memory_order_relaxed);
+                return;
+            }
+
+            for (Listener& listener : listeners)
+            {
+                MarkRemoved(listener.id);
+            }
+            for (BatchListener& listener : batchListeners)
+            {
+                MarkRemoved(listener.id);
+            }
+        }
+    };
+
+    template<typename EventType>
+    struct EventBus::ThreadChannel final : ThreadChannelBase
+    {
+        std::vector<EventType> events; // Events queued by the thread since the last ProcessEvents
+
+        void Merge(EventBus& bus, const std::size_t first, const std::size_t count) override
+        {
+            Channel<EventType>& channel = bus.GetChannel<EventType>();
+            const auto begin = events.begin() + static_cast<std::ptrdiff_t>(first);
+            channel.pending.insert(channel.pending.end(), begin, begin + static_cast<std::ptrdiff_t>(count));
+            bus.Enqueue(channel, count);
+        }
+
+        void Clear() override
+        {
+            events.clear();
+        }
+    };
+
+    template<typename EventType>
+    EventBus::Channel<EventType>& EventBus::GetChannel()
+    {
+        const std::size_t index = TypeIndex<EventFamily>::Get<EventType>();
+        if (index >= m_channels.size())
+        {
+            m_channels.resize(index + 1);
+        }
+
+        std::unique_ptr<ChannelBase>& channel = m_channels[index];
+        if (!channel)
+        {
+            channel = std::make_unique<Channel<EventType>>();
+        }
+
+        return static_cast<Channel<EventType>&>(*channel);
+    }
+
+    template<typename EventType>
+    EventBus::Channel<EventType>* EventBus::FindChannel() const
+    {
+        const std::size_t index = TypeIndex<EventFamily>::Get<EventType>();
+
+        return index < m_channels.size() ? static_cast<Channel<EventType>*>(m_channels[index].get()) : nullptr;
+    }
+
     template<typename EventType>
     ListenerID EventBus::AddListener(std::function<void(const EventType&)> listener)
     {
-        // Get the type index for this event type
-        std::type_index eventTypeIndex(typeid(EventType));
+        auto owned = std::make_unique<std::function<void(const EventType&)>>(std::move(listener));
+        const auto delegate = EventDelegate<EventType>::Bind(*owned);
+
+        return AddListener<EventType>(delegate, std::move(owned));
+    }
+
+    template<typename EventType>
+    ListenerID EventBus::AddListener(const EventDelegate<EventType> listener)
+    {
+        return AddListener<EventType>(listener, nullptr);
+    }
+
+    template<auto Method, typename T>
+    ListenerID EventBus::AddListener(T& instance)
+    {
+        using EventType = typename Detail::ListenerMethod<decltype(Method)>::Event;
+
+        return AddListener<EventType>(EventDelegate<EventType>::template Bind<Method>(instance), nullptr);
+    }
+
+    template<typename EventType>
+    ListenerID EventBus::AddListener(const EventDelegate<EventType> listener,
+                                     std::unique_ptr<std::function<void(const EventType&)>> owned)
+    {
+        Debug::Assert(static_cast<bool>(listener),
+            "EventBus::AddListener - Listener is empty: Type = %s", typeid(EventType).name());
 
         // Assign a unique ID to this listener
-        ListenerID newListenerID = m_nextListenerID++;
+        const ListenerID newListenerID = m_nextListenerID++;
+        GetChannel<EventType>().listeners.push_back({newListenerID, listener, std::move(owned)});
 
-        // Create a type-erased callback that will cast the std::any back to the correct type
-        ItemListener listenerItem(
-            newListenerID,
-            [fn = std::move(listener)](const std::any& ev) { // Capture listener by move
-                fn(std::any_cast<const EventType&>(ev));
-            }
-        );
+        return newListenerID;
+    }
 
-        // Add to the listeners for this event type
-        auto& listenerList = m_listeners[eventTypeIndex];
-        listenerList.push_back(std::move(listenerItem)); // Move the ItemListener
+    template<typename EventType>
+    ListenerID EventBus::AddBatchListener(std::function<void(std::span<const EventType>)> listener)
+    {
+        Debug::Assert(static_cast<bool>(listener),
+            "EventBus::AddBatchListener - Listener is empty: Type = %s", typeid(EventType).name());
+
+        // Batch listeners share the ID sequence, so RemoveListener finds either kind
+        const ListenerID newListenerID = m_nextListenerID++;
+        GetChannel<EventType>().batchListeners.push_back({
+            newListenerID, std::make_unique<std::function<void(std::span<const EventType>)>>(std::move(listener))});
 
         return newListenerID;
     }
@@ -40,45 +347,141 @@ namespace ecs {
     template<typename EventType>
     void EventBus::RemoveListener(const ListenerID listenerID)
     {
-        const std::type_index eventTypeIndex(typeid(EventType));
-        const auto it = m_listeners.find(eventTypeIndex);
+        Channel<EventType>* const channel = FindChannel<EventType>();
 
-        Debug::Assert(it != m_listeners.end(),
+        Debug::Assert(channel && (!channel->listeners.empty() || !channel->batchListeners.empty()),
             "EventBus::RemoveListener - No listener exist for this event type: Type = %s, ListenerID = %zu",
-            eventTypeIndex.name(), listenerID);
+            typeid(EventType).name(), listenerID);
 
-        auto listenerVec = it->second;
+        if (!channel)
+        {
+            return;
+        }
 
-        auto newEnd = std::remove_if(listenerVec.begin(), listenerVec.end(),
-            [listenerID](const ItemListener &l){ return l.id == listenerID; });
+        // Erases the listener with the ID from a list, returning whether it was found
+        const auto remove = [this, channel, listenerID](auto& listeners)
+        {
+            const auto it = std::find_if(listeners.begin(), listeners.end(),
+                [listenerID](const auto& listener) { return listener.id == listenerID; });
+            if (it == listeners.end())
+            {
+                return false;
+            }
 
-        Debug::Assert(newEnd != listenerVec.end(),
-            "EventBus::RemoveListener - Listener does not exist: Type = %s, ListenerID = %zu",
-            eventTypeIndex.name(), listenerID);
+            // A listener of a type being dispatched may still be running, and with a job system workers may start
+            // dispatching fast events of the type at any time; it is then skipped and erased by ProcessEvents
+            if (m_jobs || channel->depth.load(std::memory_order_acquire) > 0)
+            {
+                channel->MarkRemoved(it->id);
+            }
+            else
+            {
+                listeners.erase(it);
+            }
+            return true;
+        };
 
-        listenerVec.erase(newEnd, listenerVec.end());
+        const bool found = remove(channel->listeners) || remove(channel->batchListeners);
 
-        // Clean up empty listener vectors
-        if (listenerVec.empty()) {
-            m_listeners.erase(it);
-        }
+        Debug::Assert(found,
+            "EventBus::RemoveListener - Listener does not exist: Type = %s, ListenerID = %zu",
+            typeid(EventType).name(), listenerID);
     }
 
     template<typename EventType>
     void EventBus::Emit(const EventType &event, const bool fast)
     {
-        std::type_index eventTypeIndex(typeid(EventType));
-        ItemEvent item(eventTypeIndex, event);
+        SystemStatsRecorder::CountEvent();
+
+        // Workers leave the channels alone: they queue into their own buffer, and may only look up an existing channel.
+        // Events queued within ordered work are buffered with its key, on any thread, so the merge can sort them.
+        const std::size_t thread = m_jobs ? m_jobs->GetThreadIndex() : 0;
+        const std::uint64_t order = m_jobs ? JobSystem::GetOrderKey() : 0;
+
+        // Every thread that is not a worker gets index 0 and would share the bus's own queue with the owner
+        Debug::Assert(thread != 0 || std::this_thread::get_id() == m_ownerThread,
+            "EventBus::Emit - Emitted from a thread that is neither the owner nor a worker of the job system: Type = %s",
+            typeid(EventType).name());
 
         if(fast)
         {
             // Process the event immediately
-            ProcessEvent(item);
+            DispatchNow(event);
+            return;
+        }
+
+        if (thread != 0 || order != 0)
+        {
+            EmitToQueue(event, m_threadQueues[thread], order);
+            return;
+        }
+
+        // Creating a channel may move the others while workers look them up; a type without one yet is buffered
+        // and gets its channel in ProcessEvents, when no worker emits
+        Channel<EventType>* const channel = m_jobs ? FindChannel<EventType>() : &GetChannel<EventType>();
+        if (!channel)
+        {
+            EmitToQueue(event, m_threadQueues[0], order);
+            return;
+        }
+
+        // Queue the event for later processing; most events extend the last run
+        channel->pending.push_back(event);
+        if (!m_runs.empty() && m_runs.back().channel == channel)
+        {
+            ++m_runs.back().count;
+        }
+        else
+        {
+            Enqueue(*channel, 1);
+        }
+    }
+
+    template<typename EventType>
+    void EventBus::DispatchNow(const EventType& event)
+    {
+        // Only looked up: creating a channel may move the others while another thread dispatches
+        Channel<EventType>* const channel = FindChannel<EventType>();
+
+        Debug::Assert(channel != nullptr,
+            "EventBus::Emit - No listener exist for this event type: %s", typeid(EventType).name());
+
+        if (!channel)
+        {
+            return;
+        }
+
+        channel->DispatchEvent(event);
+        if (!channel->batchListeners.empty())
+        {
+            channel->DispatchBatch(std::span<const EventType>(&event, 1));
+        }
+    }
+
+    template<typename EventType>
+    void EventBus::EmitToQueue(const EventType& event, ThreadQueue& queue, const std::uint64_t order)
+    {
+        const std::size_t index = TypeIndex<EventFamily>::Get<EventType>();
+        if (index >= queue.channels.size())
+        {
+            queue.channels.resize(index + 1);
+        }
+
+        std::unique_ptr<ThreadChannelBase>& buffer = queue.channels[index];
+        if (!buffer)
+        {
+            buffer = std::make_unique<ThreadChannel<EventType>>();
+        }
+
+        std::vector<EventType>& events = static_cast<ThreadChannel<EventType>&>(*buffer).events;
+        events.push_back(event);
+        if (!queue.runs.empty() && queue.runs.back().channel == buffer.get() && queue.runs.back().order == order)
+        {
+            ++queue.runs.back().count;
         }
         else
         {
-            // Queue the event for later processing
-            m_eventQueue.push_back(std::move(item));
+            queue.runs.push_back({buffer.get(), events.size() - 1, 1, order});
         }
     }
-}
\ No newline at end of file
+}
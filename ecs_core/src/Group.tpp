@@ -0,0 +1,60 @@
+/**
+ * @file Group.tpp
+ * @brief Template implementation of Group methods.
+ */
+#pragma once
+
+namespace ecs {
+
+    template<typename... Ts>
+    Group<Ts...>::Group(const GroupStorage& storage, ComponentArray<Ts>&... arrays)
+    : m_storage(&storage)
+    , m_arrays(&arrays...)
+    {
+    }
+
+    template<typename... Ts>
+    std::size_t Group<Ts...>::Size() const
+    {
+        return m_storage->Size();
+    }
+
+    template<typename... Ts>
+    template<typename Func>
+    void Group<Ts...>::Each(Func&& func)
+    {
+        EachImpl(func, std::index_sequence_for<Ts...>{});
+    }
+
+    template<typename... Ts>
+    template<typename Func, std::size_t... Is>
+    void Group<Ts...>::EachImpl(Func& func, std::index_sequence<Is...>)
+    {
+        const std::size_t size = Size();
+        if (size == 0)
+        {
+            return;
+        }
+
+        // Members share positions in every owned array, so the arrays are walked side by side
+        const Entity* entities = std::get<0>(m_arrays)->GetEntities().data();
+        const std::tuple<Ts*...> columns { &std::get<Is>(m_arrays)->GetDataAt(0)... };
+
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            func(entities[i], std::get<Is>(columns)[i]...);
+        }
+    }
+
+    template<typename... Ts>
+    typename Group<Ts...>::Value Group<Ts...>::Iterator::operator*() const
+    {
+        Debug::Assert(m_index < m_group->Size(),
+            "Group::Iterator::operator* - Iterator out of bounds");
+
+        return std::apply([this](ComponentArray<Ts>*... arrays) {
+            return Value(std::get<0>(m_group->m_arrays)->GetEntities()[m_index], arrays->GetDataAt(m_index)...);
+        }, m_group->m_arrays);
+    }
+
+} // namespace ecs
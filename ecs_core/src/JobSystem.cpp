@@ -0,0 +1,242 @@
+/**
+* @file JobSystem.cpp
+ * @brief Implementation of the JobSystem class.
+ */
+#include <ecs/JobSystem.hpp>
+#include <string>
+#include <utility>
+#include "ecs/Tracer.hpp"
+
+namespace ecs {
+    // A job's state, shared by its handles, the queue holding it and the jobs it waits for
+    struct JobHandle::Job
+    {
+        JobSystem::Job                    function;     // Work to run; released once it ran
+        std::atomic<std::size_t>          waiting {1};  // Unfinished dependencies, plus one while being scheduled
+        std::atomic<bool>                 done {false}; // Set once the work ran
+        std::mutex                        mutex;        // Guards the two below
+        bool                              finished {false}; // Set once the work ran; later dependents are not recorded
+        std::vector<std::shared_ptr<Job>> dependents;   // Jobs waiting for this one
+    };
+
+    namespace {
+        // The pool the calling thread is a worker of, and its index there
+        thread_local const JobSystem* t_jobSystem   = nullptr;
+        thread_local std::size_t      t_threadIndex = 0;
+    }
+
+    bool JobHandle::IsDone() const
+    {
+        return !m_job || m_job->done.load(std::memory_order_acquire);
+    }
+
+    JobSystem::JobSystem(const std::size_t workerCount)
+    : m_queues(workerCount + 1)
+    , m_epoch(0)
+    , m_sleeping(0)
+    , m_stopping(false)
+    {
+        m_workers.reserve(workerCount);
+        for (std::size_t i = 1; i <= workerCount; ++i)
+        {
+            m_workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+        }
+    }
+
+    JobSystem::~JobSystem()
+    {
+        {
+            const std::lock_guard lock(m_sleepMutex);
+            m_stopping = true;
+        }
+        m_wake.notify_all();
+
+        // Without workers nobody else would run what is left
+        while (const std::shared_ptr<JobHandle::Job> job = Take(0))
+        {
+            Run(*job);
+        }
+
+        for (std::thread& worker : m_workers)
+        {
+            worker.join();
+        }
+    }
+
+    JobHandle JobSystem::Schedule(Job job)
+    {
+        return Schedule(std::move(job), {});
+    }
+
+    JobHandle JobSystem::Schedule(Job job, const std::span<const JobHandle> dependencies)
+    {
+        auto state = std::make_shared<JobHandle::Job>();
+        state->function = std::move(job);
+
+        for (const JobHandle& dependency : dependencies)
+        {
+            if (!dependency.m_job)
+            {
+                continue;
+            }
+
+            const std::lock_guard lock(dependency.m_job->mutex);
+            if (!dependency.m_job->finished)
+            {
+                dependency.m_job->dependents.push_back(state);
+                state->waiting.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        // Drop the scheduling count; if every dependency already finished the job is ready
+        if (state->waiting.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            Push(state);
+        }
+
+        return JobHandle(std::move(state));
+    }
+
+    void JobSystem::Wait(const JobHandle& handle)
+    {
+        if (!handle.m_job)
+        {
+            return;
+        }
+
+        const std::size_t thread = GetThreadIndex();
+        JobHandle::Job& job = *handle.m_job;
+        while (!job.done.load(std::memory_order_acquire))
+        {
+            if (const std::shared_ptr<JobHandle::Job> other = Take(thread))
+            {
+                Run(*other);
+                continue;
+            }
+
+            // Nothing to help with: the job is running elsewhere
+            job.done.wait(false, std::memory_order_acquire);
+        }
+    }
+
+    void JobSystem::Wait(const std::span<const JobHandle> handles)
+    {
+        for (const JobHandle& handle : handles)
+        {
+            Wait(handle);
+        }
+    }
+
+    std::size_t JobSystem::GetThreadIndex() const
+    {
+        return t_jobSystem == this ? t_threadIndex : 0;
+    }
+
+    std::size_t JobSystem::GetDefaultWorkerCount()
+    {
+        const unsigned hardwareThreads = std::thread::hardware_concurrency();
+
+        return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+    }
+
+    void JobSystem::Push(std::shared_ptr<JobHandle::Job> job)
+    {
+        Queue& queue = m_queues[GetThreadIndex()];
+        {
+            const std::lock_guard lock(queue.mutex);
+            queue.jobs.push_back(std::move(job));
+        }
+
+        // Pairs with the sleeper's increment of m_sleeping: either it sees the new epoch or we see it sleeping
+        m_epoch.fetch_add(1);
+        if (m_sleeping.load() > 0)
+        {
+            // Taking the lock makes sure a sleeper that missed the epoch is already waiting
+            { const std::lock_guard lock(m_sleepMutex); }
+            m_wake.notify_one();
+        }
+    }
+
+    std::shared_ptr<JobHandle::Job> JobSystem::Take(const std::size_t thread)
+    {
+        {
+            Queue& own = m_queues[thread];
+            const std::lock_guard lock(own.mutex);
+            if (!own.jobs.empty())
+            {
+                std::shared_ptr<JobHandle::Job> job = std::move(own.jobs.back());
+                own.jobs.pop_back();
+                return job;
+            }
+        }
+
+        for (std::size_t i = 1; i < m_queues.size(); ++i)
+        {
+            Queue& victim = m_queues[(thread + i) % m_queues.size()];
+            const std::lock_guard lock(victim.mutex);
+            if (!victim.jobs.empty())
+            {
+                std::shared_ptr<JobHandle::Job> job = std::move(victim.jobs.front());
+                victim.jobs.pop_front();
+                return job;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void JobSystem::Run(JobHandle::Job& job)
+    {
+        // A job may run inside another one that is waiting, so it must not inherit that job's order key
+        const std::uint64_t orderKey = SetOrderKey(0);
+        job.function();
+        job.function = nullptr;
+        SetOrderKey(orderKey);
+
+        std::vector<std::shared_ptr<JobHandle::Job>> dependents;
+        {
+            const std::lock_guard lock(job.mutex);
+            job.finished = true;
+            dependents.swap(job.dependents);
+        }
+
+        job.done.store(true, std::memory_order_release);
+        job.done.notify_all();
+
+        for (std::shared_ptr<JobHandle::Job>& dependent : dependents)
+        {
+            if (dependent->waiting.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                Push(std::move(dependent));
+            }
+        }
+    }
+
+    void JobSystem::WorkerLoop(const std::size_t thread)
+    {
+        t_jobSystem   = this;
+        t_threadIndex = thread;
+        Tracer::SetThreadName("Worker " + std::to_string(thread));
+
+        while (true)
+        {
+            const std::size_t epoch = m_epoch.load();
+            if (const std::shared_ptr<JobHandle::Job> job = Take(thread))
+            {
+                Run(*job);
+                continue;
+            }
+
+            std::unique_lock lock(m_sleepMutex);
+            if (m_stopping)
+            {
+                return;
+            }
+
+            m_sleeping.fetch_add(1);
+            m_wake.wait(lock, [this, epoch]() { return m_stopping || m_epoch.load() != epoch; });
+            m_sleeping.fetch_sub(1);
+        }
+    }
+
+} // namespace ecs
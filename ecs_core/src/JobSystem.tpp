@@ -0,0 +1,56 @@
+/**
+ * @file JobSystem.tpp
+ * @brief Template implementation of JobSystem methods.
+ */
+#pragma once
+
+#include <algorithm>
+
+namespace ecs {
+
+    template<typename F>
+    void JobSystem::ParallelFor(const std::size_t begin, const std::size_t end, std::size_t grain, F&& function)
+    {
+        if (begin >= end)
+        {
+            return;
+        }
+
+        grain = std::max<std::size_t>(grain, 1);
+        const std::size_t chunks = (end - begin - 1) / grain + 1;
+
+        // Chunks are claimed from a shared cursor, so a thread that finishes early just claims more
+        std::atomic<std::size_t> next(begin);
+        const std::uint64_t orderKey = GetOrderKey();
+        const auto runChunks = [&]()
+        {
+            const std::uint64_t previousKey = GetOrderKey();
+            while (true)
+            {
+                const std::size_t chunkBegin = next.fetch_add(grain, std::memory_order_relaxed);
+                if (chunkBegin >= end)
+                {
+                    break;
+                }
+
+                // Each chunk is keyed by its place in the range, not by the thread running it
+                SetOrderKey(orderKey + (chunkBegin - begin) / grain + 1);
+                function(chunkBegin, std::min(chunkBegin + grain, end));
+            }
+            SetOrderKey(previousKey);
+        };
+
+        const std::size_t helperCount = std::min(chunks - 1, m_workers.size());
+        std::vector<JobHandle> helpers;
+        helpers.reserve(helperCount);
+        for (std::size_t i = 0; i < helperCount; ++i)
+        {
+            helpers.push_back(Schedule([&runChunks]() { runChunks(); }));
+        }
+
+        runChunks();
+        Wait(helpers);
+        SetOrderKey(orderKey + chunks + 1);
+    }
+
+} // namespace ecs
@@ -0,0 +1,103 @@
+/**
+* @file PhaseScheduler.cpp
+ * @brief Implementation of the PhaseScheduler class.
+ */
+#include <ecs/PhaseScheduler.hpp>
+#include <cmath>
+#include <utility>
+#include "ecs/Debug.hpp"
+
+namespace ecs {
+    namespace {
+        // Names of the phases for the schedule dump
+        constexpr std::array<const char*, PhaseCount> PhaseNames = {"Input", "PreSim", "Sim", "PostSim", "Render"};
+    }
+
+    PhaseScheduler::PhaseScheduler(JobSystem& jobs, const float fixedStep, const std::size_t maxSteps)
+    : m_phases{Scheduler(jobs), Scheduler(jobs), Scheduler(jobs), Scheduler(jobs), Scheduler(jobs)}
+    , m_used{}
+    , m_fixedStep(fixedStep)
+    , m_maxSteps(maxSteps)
+    , m_accumulator(0.f)
+    , m_alpha(0.f)
+    {
+        Debug::Assert(fixedStep > 0.f && maxSteps > 0,
+            "PhaseScheduler - Fixed step and max steps must be positive: %f, %zu", fixedStep, maxSteps);
+    }
+
+    void PhaseScheduler::Add(const Phase phase, std::string name, std::shared_ptr<System> system)
+    {
+        GetScheduler(phase).Add(std::move(name), std::move(system));
+        m_used[static_cast<std::size_t>(phase)] = true;
+    }
+
+    void PhaseScheduler::Add(const Phase phase, std::string name, Scheduler::Task task, const SystemAccess& access)
+    {
+        GetScheduler(phase).Add(std::move(name), std::move(task), access);
+        m_used[static_cast<std::size_t>(phase)] = true;
+    }
+
+    std::size_t PhaseScheduler::Update(const float frameDt)
+    {
+        GetScheduler(Phase::Input).Update(frameDt);
+
+        m_accumulator += frameDt;
+        std::size_t steps = 0;
+        while (m_accumulator >= m_fixedStep && steps < m_maxSteps)
+        {
+            GetScheduler(Phase::PreSim).Update(m_fixedStep);
+            GetScheduler(Phase::Sim).Update(m_fixedStep);
+            GetScheduler(Phase::PostSim).Update(m_fixedStep);
+
+            m_accumulator -= m_fixedStep;
+            ++steps;
+        }
+
+        // Whole steps beyond the limit are dropped rather than carried into the next frames
+        if (m_accumulator >= m_fixedStep)
+        {
+            m_accumulator = std::fmod(m_accumulator, m_fixedStep);
+        }
+
+        m_alpha = m_accumulator / m_fixedStep;
+
+        return steps;
+    }
+
+    void PhaseScheduler::Render(const float frameDt)
+    {
+        GetScheduler(Phase::Render).Update(frameDt);
+    }
+
+    void PhaseScheduler::SetFixedStep(const float fixedStep)
+    {
+        Debug::Assert(fixedStep > 0.f,
+            "PhaseScheduler::SetFixedStep - Fixed step must be positive: %f", fixedStep);
+
+        m_fixedStep = fixedStep;
+    }
+
+    void PhaseScheduler::SetMaxSteps(const std::size_t maxSteps)
+    {
+        Debug::Assert(maxSteps > 0,
+            "PhaseScheduler::SetMaxSteps - Max steps must be positive");
+
+        m_maxSteps = maxSteps;
+    }
+
+    void PhaseScheduler::DumpSchedule(std::ostream& out) const
+    {
+        out << "Fixed step " << m_fixedStep * 1000.f << " ms, at most " << m_maxSteps << " steps per frame\n";
+        for (std::size_t i = 0; i < PhaseCount; ++i)
+        {
+            if (!m_used[i])
+            {
+                continue;
+            }
+
+            out << "Phase " << PhaseNames[i] << ":\n";
+            m_phases[i].DumpSchedule(out);
+        }
+    }
+
+} // namespace ecs
@@ -0,0 +1,39 @@
+/**
+ * @file Prefab.tpp
+ * @brief Template implementation of Prefab methods.
+ */
+#pragma once
+
+namespace ecs {
+
+    template<typename T>
+    bool Prefab::Has() const
+    {
+        const std::size_t typeIndex = TypeIndex<ComponentFamily>::Get<T>();
+        for (const Entry& entry : m_entries)
+        {
+            if (entry.typeIndex == typeIndex)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    template<typename T>
+    T* Prefab::Find()
+    {
+        const std::size_t typeIndex = TypeIndex<ComponentFamily>::Get<T>();
+        for (Entry& entry : m_entries)
+        {
+            if (entry.typeIndex == typeIndex)
+            {
+                return static_cast<T*>(entry.component.get());
+            }
+        }
+
+        return nullptr;
+    }
+
+} // namespace ecs
@@ -0,0 +1,227 @@
+/**
+* @file Scheduler.cpp
+ * @brief Implementation of the Scheduler class.
+ */
+#include <ecs/Scheduler.hpp>
+#include <algorithm>
+#include <utility>
+#include "ecs/Debug.hpp"
+
+namespace ecs {
+    Scheduler::Scheduler(JobSystem& jobs)
+    : m_jobs(jobs)
+    , m_dt(0.f)
+    , m_orderBase(0)
+    , m_updating(false)
+    {
+    }
+
+    void Scheduler::Add(std::string name, std::shared_ptr<System> system)
+    {
+        Debug::Assert(system != nullptr,
+            "Scheduler::Add - System is null: %s", name.c_str());
+
+        const SystemAccess access = system->GetAccess();
+        Add(std::move(name), [system](const float dt) { system->UpdateIfDue(dt); }, access);
+        m_nodes.back().system = std::move(system);
+    }
+
+    void Scheduler::Add(std::string name, Task task, const SystemAccess& access)
+    {
+        Debug::Assert(!m_updating,
+            "Scheduler::Add - Cannot add while updating: %s", name.c_str());
+
+        Node node;
+        node.name    = std::move(name);
+        node.task    = std::move(task);
+        node.access  = access;
+        node.level   = 0;
+        m_nodes.push_back(std::move(node));
+
+        Connect();
+    }
+
+    void Scheduler::Update(const float dt)
+    {
+        if (m_nodes.empty())
+        {
+            return;
+        }
+
+        const Clock::time_point start = Clock::now();
+        m_dt       = dt;
+        m_updating = true;
+
+        // Every node gets an order key after the calling thread's, so their results can be ordered as if run in turn
+        m_orderBase = (JobSystem::GetOrderKey() >> 32) + 1;
+        m_handles.assign(m_nodes.size(), JobHandle());
+        for (std::size_t i = 0; i < m_nodes.size(); ++i)
+        {
+            m_dependencies.clear();
+            for (const std::size_t dependency : m_nodes[i].dependencies)
+            {
+                m_dependencies.push_back(m_handles[dependency]);
+            }
+
+            // The job system has no thread affinity, so these run here; their empty handle counts as finished
+            if (m_nodes[i].access.IsMainThread())
+            {
+                m_jobs.Wait(m_dependencies);
+                Run(i);
+                continue;
+            }
+
+            m_handles[i] = m_jobs.Schedule([this, i]() { Run(i); }, m_dependencies);
+        }
+
+        m_jobs.Wait(m_handles);
+        m_updating = false;
+        JobSystem::SetOrderKey((m_orderBase + m_nodes.size()) << 32);
+
+        MeasureFrame(start, Clock::now());
+    }
+
+    void Scheduler::DumpSchedule(std::ostream& out) const
+    {
+        // Walk the critical path back from the node that finished it
+        std::vector<bool> critical(m_nodes.size(), false);
+        if (m_finish.size() == m_nodes.size() && !m_nodes.empty())
+        {
+            std::size_t node = std::max_element(m_finish.begin(), m_finish.end()) - m_finish.begin();
+            while (true)
+            {
+                critical[node] = true;
+                const auto& dependencies = m_nodes[node].dependencies;
+                if (dependencies.empty())
+                {
+                    break;
+                }
+
+                node = *std::max_element(dependencies.begin(), dependencies.end(),
+                    [this](const std::size_t a, const std::size_t b) { return m_finish[a] < m_finish[b]; });
+            }
+        }
+
+        std::size_t levels = 0;
+        for (const Node& node : m_nodes)
+        {
+            levels = std::max(levels, node.level + 1);
+        }
+
+        using Micro = std::chrono::duration<double, std::micro>;
+        out << "Schedule: " << m_nodes.size() << " systems in " << levels << " levels, "
+            << m_jobs.GetWorkerCount() << " workers\n";
+
+        for (std::size_t i = 0; i < m_nodes.size(); ++i)
+        {
+            const Node& node = m_nodes[i];
+            out << (critical[i] ? "* " : "  ") << "[" << node.level << "] " << node.name;
+            if (node.access.IsExclusive())
+            {
+                out << " (exclusive)";
+            }
+            else if (node.access.IsMainThread())
+            {
+                out << " (main thread)";
+            }
+
+            if (node.system && node.system->GetUpdateRate() > 0.f)
+            {
+                out << " (" << node.system->GetUpdateRate() << " Hz)";
+            }
+            if (node.system && node.system->GetTimeBudget() > std::chrono::nanoseconds::zero())
+            {
+                out << " (budget " << Micro(node.system->GetTimeBudget()).count() << " us)";
+            }
+
+            out << " after:";
+            if (node.dependencies.empty())
+            {
+                out << " -";
+            }
+            for (const std::size_t dependency : node.dependencies)
+            {
+                out << " " << m_nodes[dependency].name;
+            }
+
+            if (i < m_finish.size())
+            {
+                out << " | " << Micro(node.end - node.start).count() << " us";
+            }
+            out << "\n";
+        }
+
+        out << "Last frame: wall " << Micro(m_timing.wall).count()
+            << " us, serial " << Micro(m_timing.serial).count()
+            << " us, critical path " << Micro(m_timing.criticalPath).count() << " us\n";
+    }
+
+    void Scheduler::Connect()
+    {
+        const std::size_t last = m_nodes.size() - 1;
+        Node& node = m_nodes[last];
+
+        // Only edges that are not implied by other edges are kept, so the dump lists direct waits.
+        // Walking backwards, an earlier node already reached through a kept dependency needs no edge.
+        std::vector<bool> reached(last, false);
+        for (std::size_t i = last; i-- > 0;)
+        {
+            if (reached[i])
+            {
+                for (const std::size_t dependency : m_nodes[i].dependencies)
+                {
+                    reached[dependency] = true;
+                }
+                continue;
+            }
+
+            if (!node.access.ConflictsWith(m_nodes[i].access))
+            {
+                continue;
+            }
+
+            node.dependencies.push_back(i);
+            node.level = std::max(node.level, m_nodes[i].level + 1);
+            for (const std::size_t dependency : m_nodes[i].dependencies)
+            {
+                reached[dependency] = true;
+            }
+        }
+
+        std::reverse(node.dependencies.begin(), node.dependencies.end());
+    }
+
+    void Scheduler::Run(const std::size_t index)
+    {
+        Node& node = m_nodes[index];
+        const std::uint64_t orderKey = JobSystem::SetOrderKey((m_orderBase + index) << 32);
+        node.start = Clock::now();
+        node.task(m_dt);
+        node.end = Clock::now();
+        JobSystem::SetOrderKey(orderKey);
+    }
+
+    void Scheduler::MeasureFrame(const Clock::time_point start, const Clock::time_point end)
+    {
+        // Dependencies always come earlier, so one forward pass computes the longest chains
+        m_finish.assign(m_nodes.size(), std::chrono::nanoseconds(0));
+        m_timing = FrameTiming{};
+        m_timing.wall = end - start;
+
+        for (std::size_t i = 0; i < m_nodes.size(); ++i)
+        {
+            const Node& node = m_nodes[i];
+            std::chrono::nanoseconds before(0);
+            for (const std::size_t dependency : node.dependencies)
+            {
+                before = std::max(before, m_finish[dependency]);
+            }
+
+            const std::chrono::nanoseconds duration = node.end - node.start;
+            m_finish[i] = before + duration;
+            m_timing.serial += duration;
+            m_timing.criticalPath = std::max(m_timing.criticalPath, m_finish[i]);
+        }
+    }
+
+} // namespace ecs
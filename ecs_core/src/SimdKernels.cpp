@@ -0,0 +1,120 @@
+/**
+* @file SimdKernels.cpp
+ * @brief Implementation of the float column kernels.
+ */
+#include <ecs/SimdKernels.hpp>
+#include <algorithm>
+#include <bit>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define ECS_SIMD_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define ECS_SIMD_SSE2
+#endif
+
+namespace ecs::Simd {
+
+    const char* GetInstructionSet()
+    {
+#if defined(ECS_SIMD_AVX2)
+        return "AVX2";
+#elif defined(ECS_SIMD_SSE2)
+        return "SSE2";
+#else
+        return "Scalar";
+#endif
+    }
+
+    void IntegratePositions(float* positions, const float* velocities, const float dt, const std::size_t count)
+    {
+        std::size_t i = 0;
+
+#if defined(ECS_SIMD_AVX2)
+        const __m256 step = _mm256_set1_ps(dt);
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m256 position = _mm256_loadu_ps(positions + i);
+            const __m256 velocity = _mm256_loadu_ps(velocities + i);
+            _mm256_storeu_ps(positions + i, _mm256_add_ps(position, _mm256_mul_ps(velocity, step)));
+        }
+#elif defined(ECS_SIMD_SSE2)
+        const __m128 step = _mm_set1_ps(dt);
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128 position = _mm_loadu_ps(positions + i);
+            const __m128 velocity = _mm_loadu_ps(velocities + i);
+            _mm_storeu_ps(positions + i, _mm_add_ps(position, _mm_mul_ps(velocity, step)));
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            positions[i] += velocities[i] * dt;
+        }
+    }
+
+    void ClampToBounds(float* values, const float min, const float max, const std::size_t count)
+    {
+        std::size_t i = 0;
+
+#if defined(ECS_SIMD_AVX2)
+        const __m256 lower = _mm256_set1_ps(min);
+        const __m256 upper = _mm256_set1_ps(max);
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m256 value = _mm256_loadu_ps(values + i);
+            _mm256_storeu_ps(values + i, _mm256_min_ps(_mm256_max_ps(value, lower), upper));
+        }
+#elif defined(ECS_SIMD_SSE2)
+        const __m128 lower = _mm_set1_ps(min);
+        const __m128 upper = _mm_set1_ps(max);
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128 value = _mm_loadu_ps(values + i);
+            _mm_storeu_ps(values + i, _mm_min_ps(_mm_max_ps(value, lower), upper));
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            values[i] = std::min(std::max(values[i], min), max);
+        }
+    }
+
+    std::size_t DecrementLifespans(float* remaining, const float dt, const std::size_t count)
+    {
+        std::size_t expired = 0;
+        std::size_t i       = 0;
+
+#if defined(ECS_SIMD_AVX2)
+        const __m256 step = _mm256_set1_ps(dt);
+        const __m256 zero = _mm256_setzero_ps();
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m256 value = _mm256_sub_ps(_mm256_loadu_ps(remaining + i), step);
+            _mm256_storeu_ps(remaining + i, value);
+            expired += std::popcount(static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(value, zero, _CMP_LE_OQ))));
+        }
+#elif defined(ECS_SIMD_SSE2)
+        const __m128 step = _mm_set1_ps(dt);
+        const __m128 zero = _mm_setzero_ps();
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128 value = _mm_sub_ps(_mm_loadu_ps(remaining + i), step);
+            _mm_storeu_ps(remaining + i, value);
+            expired += std::popcount(static_cast<unsigned>(_mm_movemask_ps(_mm_cmple_ps(value, zero))));
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            remaining[i] -= dt;
+            expired += remaining[i] <= 0.f ? 1 : 0;
+        }
+
+        return expired;
+    }
+
+} // namespace ecs::Simd
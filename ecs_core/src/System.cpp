@@ -3,6 +3,9 @@
  * @brief Implementation of the System class.
  */
 #include <ecs/System.hpp>
+#include <typeinfo>
+#include "ecs/Debug.hpp"
+#include "ecs/Tracer.hpp"
 
 namespace ecs {
     bool System::HasEntity(const Entity entity)
@@ -29,4 +32,51 @@ namespace ecs {
 
         m_entities.Erase(entity);
     }
+
+    void System::ClearEntities()
+    {
+        m_entities.Clear();
+        m_cursor = 0;
+    }
+
+    bool System::UpdateIfDue(const float dt)
+    {
+        m_sinceUpdate += dt;
+
+        // The tolerance keeps float rounding from skipping a step, e.g. three 60 Hz steps for a 20 Hz system
+        if (m_sinceUpdate < m_updateInterval * 0.999f)
+        {
+            return false;
+        }
+
+        const float elapsed = m_sinceUpdate;
+        m_sinceUpdate = 0.f;
+
+        ECS_ZONE(typeid(*this));
+        if (m_stats)
+        {
+            m_stats->Begin();
+            Update(elapsed);
+            m_stats->End(m_entities.Size());
+        }
+        else
+        {
+            Update(elapsed);
+        }
+
+        return true;
+    }
+
+    void System::SetUpdateRate(const float hz)
+    {
+        Debug::Assert(hz >= 0.f,
+            "System::SetUpdateRate - Rate cannot be negative: %f", hz);
+
+        m_updateInterval = hz > 0.f ? 1.f / hz : 0.f;
+    }
+
+    float System::GetUpdateRate() const
+    {
+        return m_updateInterval > 0.f ? 1.f / m_updateInterval : 0.f;
+    }
 }
\ No newline at end of file
@@ -0,0 +1,112 @@
+/**
+ * @file System.tpp
+ * @brief Template implementation of System methods.
+ */
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+
+namespace ecs {
+
+    template<typename F>
+    void System::ParallelEach(std::size_t grain, F&& function)
+    {
+        // Functions taking a CommandBuffer get the chunk thread's buffer, looked up once per chunk
+        constexpr bool takesCommands = std::is_invocable_v<F&, Entity, CommandBuffer&>;
+
+        const std::vector<Entity>& entities = m_entities.GetDataVector();
+        if (!m_jobSystem)
+        {
+            if constexpr (takesCommands)
+            {
+                Debug::Assert(false,
+                    "System::ParallelEach - No CommandBuffer: the system was not registered through a Coordinator");
+                return;
+            }
+            else
+            {
+                for (const Entity entity : entities)
+                {
+                    function(entity);
+                }
+                return;
+            }
+        }
+
+        // Chunks cover whole cache lines of the packed entity array, so no line is read by two chunks
+        constexpr std::size_t lineEntities = CacheLineSize / sizeof(Entity);
+        grain = (std::max<std::size_t>(grain, 1) + lineEntities - 1) / lineEntities * lineEntities;
+
+        // Shifting indices by the array's offset into its first line puts every chunk boundary on a line boundary
+        const std::size_t shift = reinterpret_cast<std::uintptr_t>(entities.data()) % CacheLineSize / sizeof(Entity);
+        SystemStatsRecorder* const recorder = SystemStatsRecorder::GetCurrent();
+        m_jobSystem->ParallelFor(0, entities.size() + shift, grain,
+            [this, &entities, &function, shift, recorder](const std::size_t begin, const std::size_t end)
+            {
+                // Changes made by chunks on worker threads count against this system
+                SystemStatsRecorder* const previous = SystemStatsRecorder::Attribute(recorder);
+                if constexpr (takesCommands)
+                {
+                    CommandBuffer& commands = *m_commandBuffers->Local();
+                    for (std::size_t i = std::max(begin, shift) - shift; i < end - shift; ++i)
+                    {
+                        function(entities[i], commands);
+                    }
+                }
+                else
+                {
+                    for (std::size_t i = std::max(begin, shift) - shift; i < end - shift; ++i)
+                    {
+                        function(entities[i]);
+                    }
+                }
+                SystemStatsRecorder::Attribute(previous);
+            });
+    }
+
+    template<typename F>
+    bool System::EachSlice(F&& function)
+    {
+        const std::vector<Entity>& entities = m_entities.GetDataVector();
+        if (m_cursor >= entities.size())
+        {
+            m_cursor = 0;
+        }
+
+        if (m_timeBudget <= std::chrono::nanoseconds::zero())
+        {
+            for (; m_cursor < entities.size(); ++m_cursor)
+            {
+                function(entities[m_cursor]);
+            }
+
+            m_cursor = 0;
+            return true;
+        }
+
+        // Reading the clock costs about as much as light per-entity work, so it is read once per batch
+        constexpr std::size_t clockInterval = 16;
+        const auto deadline = std::chrono::steady_clock::now() + m_timeBudget;
+        for (std::size_t visited = 1; m_cursor < entities.size(); ++visited)
+        {
+            function(entities[m_cursor++]);
+
+            if (visited % clockInterval == 0 && std::chrono::steady_clock::now() >= deadline)
+            {
+                break;
+            }
+        }
+
+        if (m_cursor < entities.size())
+        {
+            return false;
+        }
+
+        m_cursor = 0;
+        return true;
+    }
+
+} // namespace ecs
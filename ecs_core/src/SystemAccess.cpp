@@ -0,0 +1,66 @@
+/**
+* @file SystemAccess.cpp
+ * @brief Implementation of the SystemAccess class.
+ */
+#include <ecs/SystemAccess.hpp>
+#include <algorithm>
+
+namespace ecs {
+    SystemAccess& SystemAccess::MainThread()
+    {
+        m_mainThread = true;
+        m_declared   = true;
+
+        return *this;
+    }
+
+    SystemAccess& SystemAccess::Exclusive()
+    {
+        m_exclusive = true;
+        m_declared  = true;
+
+        return *this;
+    }
+
+    bool SystemAccess::ConflictsWith(const SystemAccess& other) const
+    {
+        if (IsExclusive() || other.IsExclusive())
+        {
+            return true;
+        }
+
+        return Intersects(m_writes, other.m_writes)
+            || Intersects(m_writes, other.m_reads)
+            || Intersects(m_reads, other.m_writes)
+            || Intersects(m_fastEmits, other.m_listens)
+            || Intersects(m_listens, other.m_fastEmits)
+            || Intersects(m_fastEmits, other.m_fastEmits);
+    }
+
+    void SystemAccess::Insert(std::vector<std::size_t>& set, const std::size_t index)
+    {
+        const auto it = std::lower_bound(set.begin(), set.end(), index);
+        if (it == set.end() || *it != index)
+        {
+            set.insert(it, index);
+        }
+    }
+
+    bool SystemAccess::Intersects(const std::vector<std::size_t>& first, const std::vector<std::size_t>& second)
+    {
+        auto a = first.begin();
+        auto b = second.begin();
+        while (a != first.end() && b != second.end())
+        {
+            if (*a == *b)
+            {
+                return true;
+            }
+
+            *a < *b ? ++a : ++b;
+        }
+
+        return false;
+    }
+
+} // namespace ecs
@@ -0,0 +1,54 @@
+/**
+ * @file SystemAccess.tpp
+ * @brief Template implementation of SystemAccess methods.
+ */
+#pragma once
+
+namespace ecs {
+
+    template<typename... Ts>
+    SystemAccess& SystemAccess::Read()
+    {
+        (Insert(m_reads, TypeIndex<ComponentFamily>::Get<Ts>()), ...);
+        m_declared = true;
+
+        return *this;
+    }
+
+    template<typename... Ts>
+    SystemAccess& SystemAccess::Write()
+    {
+        (Insert(m_writes, TypeIndex<ComponentFamily>::Get<Ts>()), ...);
+        m_declared = true;
+
+        return *this;
+    }
+
+    template<typename... Es>
+    SystemAccess& SystemAccess::Emit()
+    {
+        (Insert(m_emits, TypeIndex<EventFamily>::Get<Es>()), ...);
+        m_declared = true;
+
+        return *this;
+    }
+
+    template<typename... Es>
+    SystemAccess& SystemAccess::EmitFast()
+    {
+        (Insert(m_fastEmits, TypeIndex<EventFamily>::Get<Es>()), ...);
+        m_declared = true;
+
+        return *this;
+    }
+
+    template<typename... Es>
+    SystemAccess& SystemAccess::Listen()
+    {
+        (Insert(m_listens, TypeIndex<EventFamily>::Get<Es>()), ...);
+        m_declared = true;
+
+        return *this;
+    }
+
+} // namespace ecs
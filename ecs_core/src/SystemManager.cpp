@@ -3,22 +3,154 @@
  * @brief Implementation of the SystemManager class.
  */
 #include <ecs/SystemManager.hpp>
+#include <algorithm>
+#include <bit>
+#include <utility>
+#include "ecs/Debug.hpp"
 
 namespace ecs {
-    void SystemManager::EntitySignatureChanged(const Entity entity, const Signature entitySig)
+    void SystemManager::EntitySignatureChanged(const Entity entity, const Signature oldSignature, const Signature newSignature)
     {
-        for (auto const& [typeName, system] : m_systems)
+        const auto changed = (oldSignature ^ newSignature).to_ullong();
+        for (auto bits = changed; bits; bits &= bits - 1)
         {
-            auto const& systemSig = m_signatures.at(typeName); // Assumes typeName exists in m_signatures (should be guaranteed by registration)
-            if ((entitySig & systemSig) == systemSig)
+            const ComponentTypeID type = std::countr_zero(bits);
+            const Signature earlier(changed & ((1ull << type) - 1));
+
+            for (const std::size_t slot : m_interested[type])
+            {
+                auto const& systemSig = m_signatures[slot];
+
+                // A system requiring several changed components is handled at the first of them
+                if ((systemSig & earlier).any())
+                {
+                    continue;
+                }
+
+                const bool matchedBefore = (oldSignature & systemSig) == systemSig;
+                const bool matchesNow    = (newSignature & systemSig) == systemSig;
+                if (matchesNow && !matchedBefore)
+                {
+                    m_systems[slot]->AddEntity(entity);
+                }
+                else if (matchedBefore && !matchesNow)
+                {
+                    m_systems[slot]->RemoveEntity(entity);
+                }
+            }
+        }
+    }
+
+    void SystemManager::EntitiesCreated(const std::span<const Entity> entities, const Signature entitySig)
+    {
+        for (std::size_t slot = 0; slot < m_systems.size(); ++slot)
+        {
+            auto const& systemSig = m_signatures[slot];
+            if (systemSig.none() || (entitySig & systemSig) != systemSig)
+            {
+                continue;
+            }
+
+            for (const Entity entity : entities)
+            {
+                m_systems[slot]->AddEntity(entity);
+            }
+        }
+    }
+
+    void SystemManager::EntitiesDestroyed(const std::span<const Entity> entities, const Signature entitySig)
+    {
+        const auto held = entitySig.to_ullong();
+        for (auto bits = held; bits; bits &= bits - 1)
+        {
+            const ComponentTypeID type = std::countr_zero(bits);
+            const Signature earlier(held & ((1ull << type) - 1));
+
+            for (const std::size_t slot : m_interested[type])
+            {
+                auto const& systemSig = m_signatures[slot];
+
+                // Each system is handled at the first component it shares with the entities
+                if ((systemSig & earlier).any() || (entitySig & systemSig) != systemSig)
+                {
+                    continue;
+                }
+
+                for (const Entity entity : entities)
+                {
+                    m_systems[slot]->RemoveEntity(entity);
+                }
+            }
+        }
+    }
+
+    void SystemManager::IndexSystem(const std::size_t slot, const bool add)
+    {
+        for (auto bits = m_signatures[slot].to_ullong(); bits; bits &= bits - 1)
+        {
+            std::vector<std::size_t>& systems = m_interested[std::countr_zero(bits)];
+            if (add)
             {
-                system->AddEntity(entity);
+                systems.push_back(slot);
             }
             else
             {
-                system->RemoveEntity(entity);
+                systems.erase(std::find(systems.begin(), systems.end(), slot));
             }
         }
     }
 
+    void SystemManager::Clear()
+    {
+        for (const auto& system : m_systems)
+        {
+            system->ClearEntities();
+        }
+    }
+
+    void SystemManager::EnableStats(const std::size_t window)
+    {
+        Debug::Assert(window > 0,
+            "SystemManager::EnableStats - Window must hold at least one update");
+
+        m_statsWindow = window;
+        for (std::size_t slot = 0; slot < m_systems.size(); ++slot)
+        {
+            auto recorder = std::make_unique<SystemStatsRecorder>(m_names[slot], window, m_onOverrun);
+            recorder->SetBudget(m_budgets[slot]);
+            m_systems[slot]->m_stats = std::move(recorder);
+        }
+    }
+
+    void SystemManager::DisableStats()
+    {
+        m_statsWindow = 0;
+        for (const auto& system : m_systems)
+        {
+            system->m_stats.reset();
+        }
+    }
+
+    std::vector<SystemStats> SystemManager::GetStats() const
+    {
+        std::vector<SystemStats> stats;
+        if (m_statsWindow == 0)
+        {
+            return stats;
+        }
+
+        stats.reserve(m_systems.size());
+        for (const auto& system : m_systems)
+        {
+            stats.push_back(system->m_stats->GetStats());
+        }
+
+        return stats;
+    }
+
+    void SystemManager::SetBudgetOverrunCallback(BudgetOverrunCallback callback)
+    {
+        m_onOverrun = std::move(callback);
+    }
+
 } // namespace ecs
\ No newline at end of file
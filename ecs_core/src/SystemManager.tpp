@@ -13,14 +13,27 @@ namespace ecs {
     template<typename T, typename... Args>
     std::shared_ptr<T> SystemManager::RegisterSystem(Args&&... args)
     {
-        const char* typeName = typeid(T).name();
-        Debug::Assert(!m_systems.contains(typeName),
+        Debug::Assert(GetSlot<T>() == UnregisteredSlot,
             "SystemManager::RegisterSystem - Registering system type more than once: %s",
-            typeName);
+            typeid(T).name());
+
+        const std::size_t typeIndex = TypeIndex<SystemFamily>::Get<T>();
+        if (typeIndex >= m_slots.size())
+        {
+            m_slots.resize(typeIndex + 1, UnregisteredSlot);
+        }
 
         // Create and store the system
         auto system = std::make_shared<T>(std::forward<Args>(args)...);
-        m_systems.insert({typeName, system});
+        m_slots[typeIndex] = m_systems.size();
+        m_systems.push_back(system);
+        m_signatures.emplace_back();
+        m_names.emplace_back(typeid(T).name());
+        m_budgets.emplace_back(0);
+        if (m_statsWindow > 0)
+        {
+            system->m_stats = std::make_unique<SystemStatsRecorder>(m_names.back(), m_statsWindow, m_onOverrun);
+        }
 
         return system;
     }
@@ -28,24 +41,49 @@ namespace ecs {
     template<typename T>
     void SystemManager::SetSystemSignature(const Signature signature)
     {
-        const char* typeName = typeid(T).name();
-        Debug::Assert(m_systems.contains(typeName),
-            "SystemManager::GetSystem - System type not registered: %s",
-            typeName);
+        const std::size_t slot = GetSlot<T>();
+        Debug::Assert(slot != UnregisteredSlot,
+            "SystemManager::SetSystemSignature - System type not registered: %s",
+            typeid(T).name());
 
         // Store what component types the system is interested in
-        m_signatures[typeName] = signature;
+        IndexSystem(slot, false);
+        m_signatures[slot] = signature;
+        IndexSystem(slot, true);
+    }
+
+    template<typename T>
+    void SystemManager::SetBudget(const std::chrono::nanoseconds budget)
+    {
+        const std::size_t slot = GetSlot<T>();
+        Debug::Assert(slot != UnregisteredSlot,
+            "SystemManager::SetBudget - System type not registered: %s",
+            typeid(T).name());
+
+        m_budgets[slot] = budget;
+        if (m_systems[slot]->m_stats)
+        {
+            m_systems[slot]->m_stats->SetBudget(budget);
+        }
     }
 
     template<typename T>
     std::shared_ptr<T> SystemManager::GetSystem()
     {
-        const char* typeName = typeid(T).name();
-        Debug::Assert(m_systems.contains(typeName),
+        const std::size_t slot = GetSlot<T>();
+        Debug::Assert(slot != UnregisteredSlot,
             "SystemManager::GetSystem - System type not registered: %s",
-            typeName);
+            typeid(T).name());
+
+        return std::static_pointer_cast<T>(m_systems[slot]);
+    }
+
+    template<typename T>
+    std::size_t SystemManager::GetSlot() const
+    {
+        const std::size_t typeIndex = TypeIndex<SystemFamily>::Get<T>();
 
-        return std::static_pointer_cast<T>(m_systems.at(typeName));
+        return typeIndex < m_slots.size() ? m_slots[typeIndex] : UnregisteredSlot;
     }
 
 } // namespace ecs
\ No newline at end of file
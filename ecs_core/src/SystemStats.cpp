@@ -0,0 +1,94 @@
+/**
+ * @file SystemStats.cpp
+ * @brief Implementation of the SystemStatsRecorder class.
+ */
+#include <ecs/SystemStats.hpp>
+#include <algorithm>
+#include <utility>
+#include "ecs/Debug.hpp"
+
+namespace ecs {
+
+    SystemStatsRecorder::SystemStatsRecorder(std::string name, const std::size_t window, const BudgetOverrunCallback& onOverrun)
+    : m_name(std::move(name))
+    , m_onOverrun(onOverrun)
+    , m_samples(window)
+    {
+        Debug::Assert(window > 0,
+            "SystemStatsRecorder - Window must hold at least one update: %s", m_name.c_str());
+    }
+
+    void SystemStatsRecorder::Begin()
+    {
+        m_structuralChanges.store(0, std::memory_order_relaxed);
+        m_eventsEmitted.store(0, std::memory_order_relaxed);
+        m_previous = Attribute(this);
+        m_start = std::chrono::steady_clock::now();
+    }
+
+    void SystemStatsRecorder::End(const std::size_t entities)
+    {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start);
+        Attribute(m_previous);
+
+        m_samples[m_next] = {elapsed,
+                             m_structuralChanges.load(std::memory_order_relaxed),
+                             m_eventsEmitted.load(std::memory_order_relaxed)};
+        m_next = (m_next + 1) % m_samples.size();
+        m_count = std::min(m_count + 1, m_samples.size());
+        m_entities = entities;
+
+        if (m_budget > std::chrono::nanoseconds::zero() && elapsed > m_budget)
+        {
+            ++m_overruns;
+            if (m_onOverrun)
+            {
+                m_onOverrun(m_name, elapsed, m_budget);
+            }
+        }
+    }
+
+    SystemStats SystemStatsRecorder::GetStats() const
+    {
+        SystemStats stats;
+        stats.name = m_name;
+        stats.updates = m_count;
+        stats.entities = m_entities;
+        stats.budget = m_budget;
+        stats.overruns = m_overruns;
+        if (m_count == 0)
+        {
+            return stats;
+        }
+
+        // Until the ring wrapped, the valid samples are its first m_count entries
+        std::vector<std::chrono::nanoseconds> durations;
+        durations.reserve(m_count);
+        std::chrono::nanoseconds total {0};
+        for (std::size_t i = 0; i < m_count; ++i)
+        {
+            const Sample& sample = m_samples[i];
+            durations.push_back(sample.duration);
+            total += sample.duration;
+            stats.structuralChanges += sample.structuralChanges;
+            stats.eventsEmitted += sample.eventsEmitted;
+        }
+
+        // Nearest-rank percentiles
+        const auto percentile = [&durations](const std::size_t percent)
+        {
+            const std::size_t rank = (durations.size() * percent + 99) / 100;
+            const auto nth = durations.begin() + static_cast<std::ptrdiff_t>(std::max<std::size_t>(rank, 1) - 1);
+            std::nth_element(durations.begin(), nth, durations.end());
+            return *nth;
+        };
+
+        stats.mean = total / static_cast<std::int64_t>(m_count);
+        stats.p50 = percentile(50);
+        stats.p99 = percentile(99);
+        stats.max = *std::max_element(durations.begin(), durations.end());
+
+        return stats;
+    }
+
+} // namespace ecs
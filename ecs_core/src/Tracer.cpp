@@ -0,0 +1,269 @@
+/**
+ * @file Tracer.cpp
+ * @brief Implementation of the Tracer class.
+ */
+#include <ecs/Tracer.hpp>
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "ecs/Debug.hpp"
+
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
+
+namespace ecs {
+
+    namespace {
+
+        // A finished zone
+        struct Zone
+        {
+            const char*  name;     // Zone name
+            std::int64_t begin;    // Start time in nanoseconds
+            std::int64_t end;      // End time in nanoseconds
+            bool         typeName; // Whether name is a mangled type name
+        };
+
+        // Zones of one thread. Only the owning thread writes; the exporter reads once recording stopped.
+        struct ThreadBuffer
+        {
+            std::unique_ptr<Zone[]>    zones;        // Ring of the latest zones, left uninitialized so allocating it touches no memory
+            std::size_t                capacity = 0; // Size of the ring, a power of two
+            std::atomic<std::uint64_t> written {0};  // Zones written in the current session, including overwritten ones
+            std::atomic<std::uint64_t> session {0};  // Recording session the zones belong to
+            std::size_t                track;        // Track number in written traces
+            std::string                name;         // Track name, guarded by the registry mutex
+        };
+
+        // Buffers of every thread that recorded a zone. Buffers outlive their threads so their zones can still be written.
+        struct Registry
+        {
+            std::mutex                                 mutex;           // Guards buffers and thread names
+            std::vector<std::unique_ptr<ThreadBuffer>> buffers;         // Buffers in registration order
+            std::atomic<std::size_t>                   capacity {65536}; // Zones per buffer from the next session
+            std::atomic<std::uint64_t>                 session {0};     // Bumped by every Start, so buffers discard older zones lazily
+            std::atomic<std::size_t>                   framesLeft {0};  // EndFrame calls until recording stops; zero for none
+        };
+
+        Registry& GetRegistry()
+        {
+            static Registry registry;
+            return registry;
+        }
+
+        thread_local ThreadBuffer* t_buffer = nullptr; // Buffer of the calling thread, created by its first zone
+
+        ThreadBuffer& GetThreadBuffer()
+        {
+            if (!t_buffer)
+            {
+                Registry& registry = GetRegistry();
+                const std::lock_guard lock(registry.mutex);
+                auto buffer = std::make_unique<ThreadBuffer>();
+                buffer->track = registry.buffers.size() + 1;
+                buffer->name = "Thread " + std::to_string(buffer->track);
+                t_buffer = buffer.get();
+                registry.buffers.push_back(std::move(buffer));
+            }
+
+            return *t_buffer;
+        }
+
+        // Writes a string as a JSON string literal
+        void WriteJsonString(std::ostream& out, const std::string& text)
+        {
+            static constexpr char hex[] = "0123456789abcdef";
+
+            out << '"';
+            for (const char c : text)
+            {
+                if (c == '"' || c == '\\')
+                {
+                    out << '\\' << c;
+                }
+                else if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    out << "\\u00" << hex[(c >> 4) & 0xf] << hex[c & 0xf];
+                }
+                else
+                {
+                    out << c;
+                }
+            }
+            out << '"';
+        }
+
+        // Writes nanoseconds as microseconds with three decimals, the unit of Chrome traces
+        void WriteMicroseconds(std::ostream& out, const std::int64_t nanoseconds)
+        {
+            const std::int64_t fraction = nanoseconds % 1000;
+            out << nanoseconds / 1000 << '.'
+                << static_cast<char>('0' + fraction / 100)
+                << static_cast<char>('0' + fraction / 10 % 10)
+                << static_cast<char>('0' + fraction % 10);
+        }
+
+        // Turns the name of a zone into readable text
+        std::string ZoneName(const Zone& zone)
+        {
+#if defined(__GNUG__)
+            if (zone.typeName)
+            {
+                int status = 0;
+                char* demangled = abi::__cxa_demangle(zone.name, nullptr, nullptr, &status);
+                if (status == 0 && demangled)
+                {
+                    std::string name(demangled);
+                    std::free(demangled);
+                    return name;
+                }
+            }
+#endif
+            return zone.name;
+        }
+
+    } // namespace
+
+    void Tracer::Start(const std::size_t frames)
+    {
+        Registry& registry = GetRegistry();
+        registry.framesLeft.store(frames, std::memory_order_relaxed);
+        registry.session.fetch_add(1, std::memory_order_relaxed);
+        s_recording.store(true, std::memory_order_relaxed);
+    }
+
+    void Tracer::Stop()
+    {
+        s_recording.store(false, std::memory_order_relaxed);
+    }
+
+    bool Tracer::EndFrame()
+    {
+        if (!IsRecording())
+        {
+            return false;
+        }
+
+        Registry& registry = GetRegistry();
+        const std::size_t left = registry.framesLeft.load(std::memory_order_relaxed);
+        if (left == 0)
+        {
+            return false;
+        }
+
+        registry.framesLeft.store(left - 1, std::memory_order_relaxed);
+        if (left > 1)
+        {
+            return false;
+        }
+
+        Stop();
+        return true;
+    }
+
+    void Tracer::SetThreadName(std::string name)
+    {
+        ThreadBuffer& buffer = GetThreadBuffer();
+        const std::lock_guard lock(GetRegistry().mutex);
+        buffer.name = std::move(name);
+    }
+
+    void Tracer::SetBufferCapacity(const std::size_t zones)
+    {
+        Debug::Assert(zones > 0,
+            "Tracer::SetBufferCapacity - Buffers must hold at least one zone");
+
+        GetRegistry().capacity.store(std::bit_ceil(zones), std::memory_order_relaxed);
+    }
+
+    void Tracer::Record(const char* name, const bool typeName, const std::int64_t begin, const std::int64_t end)
+    {
+        ThreadBuffer& buffer = GetThreadBuffer();
+
+        // The first zone of a session drops the previous session's zones; the ring is reused unless resized
+        const std::uint64_t session = GetRegistry().session.load(std::memory_order_relaxed);
+        if (buffer.session.load(std::memory_order_relaxed) != session)
+        {
+            const std::size_t capacity = GetRegistry().capacity.load(std::memory_order_relaxed);
+            if (buffer.capacity != capacity)
+            {
+                buffer.zones.reset(new Zone[capacity]);
+                buffer.capacity = capacity;
+            }
+            buffer.written.store(0, std::memory_order_relaxed);
+            buffer.session.store(session, std::memory_order_release);
+        }
+
+        const std::uint64_t index = buffer.written.load(std::memory_order_relaxed);
+        buffer.zones[index & (buffer.capacity - 1)] = {name, begin, end, typeName};
+        buffer.written.store(index + 1, std::memory_order_release);
+    }
+
+    void Tracer::WriteChromeTrace(std::ostream& out)
+    {
+        Debug::Assert(!IsRecording(),
+            "Tracer::WriteChromeTrace - Stop recording before writing the trace");
+
+        Registry& registry = GetRegistry();
+        const std::lock_guard lock(registry.mutex);
+        const std::uint64_t session = registry.session.load(std::memory_order_relaxed);
+
+        // The zones of each buffer that belong to the last session, oldest first
+        struct Range
+        {
+            const ThreadBuffer* buffer; // The buffer
+            std::uint64_t       first;  // Index of the oldest zone kept
+            std::uint64_t       end;    // One past the newest zone
+        };
+
+        std::vector<Range> ranges;
+        std::int64_t origin = std::numeric_limits<std::int64_t>::max();
+        for (const auto& buffer : registry.buffers)
+        {
+            if (buffer->session.load(std::memory_order_acquire) != session)
+            {
+                continue;
+            }
+
+            const std::uint64_t end = buffer->written.load(std::memory_order_acquire);
+            const std::uint64_t first = end - std::min<std::uint64_t>(end, buffer->capacity);
+            for (std::uint64_t i = first; i < end; ++i)
+            {
+                origin = std::min(origin, buffer->zones[i & (buffer->capacity - 1)].begin);
+            }
+            ranges.push_back({buffer.get(), first, end});
+        }
+
+        // Times are written relative to the earliest zone, which keeps the numbers short
+        out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        bool first = true;
+        for (const Range& range : ranges)
+        {
+            out << (first ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+                << range.buffer->track << ",\"args\":{\"name\":";
+            WriteJsonString(out, range.buffer->name);
+            out << "}}";
+            first = false;
+
+            for (std::uint64_t i = range.first; i < range.end; ++i)
+            {
+                const Zone& zone = range.buffer->zones[i & (range.buffer->capacity - 1)];
+                out << ",\n{\"name\":";
+                WriteJsonString(out, ZoneName(zone));
+                out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << range.buffer->track << ",\"ts\":";
+                WriteMicroseconds(out, zone.begin - origin);
+                out << ",\"dur\":";
+                WriteMicroseconds(out, zone.end - zone.begin);
+                out << '}';
+            }
+        }
+        out << "\n]}\n";
+    }
+
+} // namespace ecs
@@ -0,0 +1,228 @@
+/**
+ * @file View.tpp
+ * @brief Template implementation of View methods.
+ */
+#pragma once
+
+namespace ecs {
+
+    template<typename... Ts>
+    View<Ts...>::View(const EntityManager& entityManager, const Signature tags, ComponentArray<Ts>&... arrays)
+    : m_arrays(&arrays...)
+    , m_signatures(&entityManager)
+    , m_tags(tags)
+    , m_driver(0)
+    , m_types()
+    {
+        // Drive iteration from the array with the fewest entities
+        const std::vector<Entity>* entityLists[] = { &arrays.GetEntities()... };
+        for (std::size_t i = 1; i < sizeof...(Ts); ++i)
+        {
+            if (entityLists[i]->size() < entityLists[m_driver]->size())
+            {
+                m_driver = i;
+            }
+        }
+
+        m_entities = entityLists[m_driver];
+    }
+
+    template<typename... Ts>
+    View<Ts...>::View(const ArchetypeStorage& storage, const std::array<ComponentTypeID, sizeof...(Ts)>& types,
+                      const Signature tags)
+    : m_signatures(nullptr)
+    , m_driver(0)
+    , m_entities(nullptr)
+    , m_types(types)
+    {
+        // Tags are part of archetype signatures, so they only narrow the match
+        Signature signature = tags;
+        for (const ComponentTypeID type : types)
+        {
+            signature.set(type);
+        }
+
+        storage.GetMatchingArchetypes(signature, m_archetypes);
+    }
+
+    template<typename... Ts>
+    template<typename Func>
+    void View<Ts...>::Each(Func&& func)
+    {
+        if (m_entities)
+        {
+            EachDispatch(func, std::index_sequence_for<Ts...>{});
+        }
+        else
+        {
+            EachChunk(func, std::index_sequence_for<Ts...>{});
+        }
+    }
+
+    template<typename... Ts>
+    std::size_t View<Ts...>::SizeHint() const
+    {
+        if (m_entities)
+        {
+            return m_entities->size();
+        }
+
+        std::size_t size = 0;
+        for (const Archetype* archetype : m_archetypes)
+        {
+            size += archetype->Size();
+        }
+
+        return size;
+    }
+
+    template<typename... Ts>
+    template<typename Func, std::size_t... Is>
+    void View<Ts...>::EachDispatch(Func& func, std::index_sequence<Is...> indices)
+    {
+        // Run the loop specialised for whichever array is the smallest
+        ((m_driver == Is ? (EachFrom<Is>(func, indices), true) : false) || ...);
+    }
+
+    template<typename... Ts>
+    template<std::size_t Driver, typename Func, std::size_t... Is>
+    void View<Ts...>::EachFrom(Func& func, std::index_sequence<Is...>)
+    {
+        auto& driver = *std::get<Driver>(m_arrays);
+        const std::vector<Entity>& entities = driver.GetEntities();
+
+        for (std::size_t i = 0; i < entities.size(); ++i)
+        {
+            const Entity entity = entities[i];
+
+            // The driving component sits at the same position as its entity; the others are looked up
+            const std::tuple<Ts*...> components {
+                [&]() -> Ts* {
+                    if constexpr (Is == Driver)
+                    {
+                        return &driver.GetDataAt(i);
+                    }
+                    else
+                    {
+                        return std::get<Is>(m_arrays)->TryGetData(entity);
+                    }
+                }()...
+            };
+
+            if ((... && (Is == Driver || std::get<Is>(components) != nullptr)) && HasTags(entity))
+            {
+                func(entity, *std::get<Is>(components)...);
+            }
+        }
+    }
+
+    template<typename... Ts>
+    template<typename Func, std::size_t... Is>
+    void View<Ts...>::EachChunk(Func& func, std::index_sequence<Is...>)
+    {
+        for (Archetype* archetype : m_archetypes)
+        {
+            for (std::size_t chunk = 0; chunk < archetype->GetChunkCount(); ++chunk)
+            {
+                const std::size_t count    = archetype->GetChunkSize(chunk);
+                const Entity*     entities = archetype->GetEntities(chunk);
+                const std::tuple<Ts*...> columns { archetype->template GetColumn<Ts>(chunk, m_types[Is])... };
+
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    func(entities[i], std::get<Is>(columns)[i]...);
+                }
+            }
+        }
+    }
+
+    template<typename... Ts>
+    template<std::size_t... Is>
+    void View<Ts...>::ResolveRow(Archetype& archetype, const std::size_t row, std::tuple<Ts*...>& components,
+                                 std::index_sequence<Is...>) const
+    {
+        components = { static_cast<Ts*>(archetype.GetComponent(row, m_types[Is]))... };
+    }
+
+    template<typename... Ts>
+    bool View<Ts...>::Resolve(const Entity entity, std::tuple<Ts*...>& components) const
+    {
+        return std::apply([entity, &components](ComponentArray<Ts>*... arrays) {
+            return (... && ((std::get<Ts*>(components) = arrays->TryGetData(entity)) != nullptr));
+        }, m_arrays) && HasTags(entity);
+    }
+
+    template<typename... Ts>
+    bool View<Ts...>::HasTags(const Entity entity) const
+    {
+        return m_tags.none() || (m_signatures->GetSignature(entity) & m_tags) == m_tags;
+    }
+
+    // Iterator
+    template<typename... Ts>
+    View<Ts...>::Iterator::Iterator(View* view, const std::size_t archetype, const std::size_t index)
+    : m_view(view)
+    , m_archetype(archetype)
+    , m_index(index)
+    , m_entity(NullEntity)
+    {
+        SkipMismatches();
+    }
+
+    template<typename... Ts>
+    typename View<Ts...>::Iterator& View<Ts...>::Iterator::operator++()
+    {
+        ++m_index;
+        SkipMismatches();
+        return *this;
+    }
+
+    template<typename... Ts>
+    typename View<Ts...>::Value View<Ts...>::Iterator::operator*() const
+    {
+        Debug::Assert(m_entity != NullEntity,
+            "View::Iterator::operator* - Iterator out of bounds");
+
+        return std::apply([this](Ts*... components) {
+            return Value(m_entity, *components...);
+        }, m_components);
+    }
+
+    template<typename... Ts>
+    void View<Ts...>::Iterator::SkipMismatches()
+    {
+        m_entity = NullEntity;
+
+        if (m_view->m_entities)
+        {
+            const std::vector<Entity>& entities = *m_view->m_entities;
+            while (m_index < entities.size() && !m_view->Resolve(entities[m_index], m_components))
+            {
+                ++m_index;
+            }
+
+            if (m_index < entities.size())
+            {
+                m_entity = entities[m_index];
+            }
+
+            return;
+        }
+
+        // Every row of a matching archetype matches; only empty archetypes are skipped
+        const std::vector<Archetype*>& archetypes = m_view->m_archetypes;
+        while (m_archetype < archetypes.size() && m_index >= archetypes[m_archetype]->Size())
+        {
+            ++m_archetype;
+            m_index = 0;
+        }
+
+        if (m_archetype < archetypes.size())
+        {
+            Archetype& archetype = *archetypes[m_archetype];
+            m_entity = archetype.GetEntity(m_index);
+            m_view->ResolveRow(archetype, m_index, m_components, std::index_sequence_for<Ts...>{});
+        }
+    }
+
+} // namespace ecs
@@ -3,11 +3,15 @@
  * @brief Component for entities with a limited lifetime.
  *
  * The LifespanComponent tracks how long an entity should exist
- * before being automatically destroyed.
+ * before being automatically destroyed. It is stored as structure-of-arrays
+ * so the LifespanSystem can age every entity with one vectorized pass.
  */
 #ifndef LIFESPANCOMPONENT_HPP
 #define LIFESPANCOMPONENT_HPP
 
+#include <type_traits>
+#include <ecs/SoALayout.hpp>
+
 struct LifespanComponent
 {
     float total;      // Total lifetime in seconds
@@ -20,4 +24,7 @@ struct LifespanComponent
     }
 };
 
+template<>
+struct ecs::SoALayout<LifespanComponent> : std::true_type { };
+
 #endif //LIFESPANCOMPONENT_HPP
\ No newline at end of file
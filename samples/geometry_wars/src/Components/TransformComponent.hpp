@@ -12,6 +12,9 @@ struct TransformComponent
     float rotation = 0.f;  // Rotation in degrees
     float scale = 1.f;     // Scale factor
     float angle = 0.f;     // Angular velocity
+
+    Vec2<float> previousPosition = position;  // Position before the last simulation step, for render interpolation
+    float previousRotation = rotation;        // Rotation before the last simulation step, for render interpolation
 };
 
 #endif //TRANSFORMCOMPONENT_HPP
\ No newline at end of file
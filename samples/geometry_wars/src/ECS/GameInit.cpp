@@ -67,6 +67,9 @@ namespace GameInit
         coordinator.RegisterComponent<TagComponent>();
         coordinator.RegisterComponent<AdvancedEnemyComponent>();
         coordinator.RegisterComponent<HealthChangeComponent>();
+
+        // Keep moving entities packed in the same order for MovementSystem
+        coordinator.Group<TransformComponent, VelocityComponent>();
     }
     void RegisterAllSystems(sf::RenderWindow& window, ecs::Coordinator& coordinator, ecs::EventBus& eventBus)
     {
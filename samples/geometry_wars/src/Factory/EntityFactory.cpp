@@ -7,6 +7,7 @@
 #include <random>
 #include <cmath>
 #include <numbers>
+#include <vector>
 
 #include "Managers/ConfigManager.hpp"
 #include "Core/Math/Vec2.hpp"
@@ -37,8 +38,6 @@ namespace EntityFactory
 {
     ecs::Entity SpawnPlayer(sf::RenderWindow& window, ecs::Coordinator& coordinator)
     {
-        const ecs::Entity e = coordinator.CreateEntity();
-
         const auto& pConfig   = gConfig.GetGameConfig().player;
         const auto& sConfig   = gConfig.GetGameConfig().sonar;
         const auto& gunConfig = gConfig.GetGameConfig().bullet;
@@ -46,18 +45,6 @@ namespace EntityFactory
         const float posX = static_cast<float>(window.getSize().x) / 2.f;
         const float posY = static_cast<float>(window.getSize().y) / 2.f;
 
-        coordinator.AddComponent<PlayerComponent>(e, {}); // Tag as player
-        coordinator.AddComponent<TagComponent>(e, {EntityType::PLAYER}); // Add specific type tag
-        coordinator.AddComponent<InputComponent>(e, {}); // Mark for input handling
-        coordinator.AddComponent<TransformComponent>(e, {Vec2<float>(posX, posY), 0.f, 1.f, pConfig.rot});
-        coordinator.AddComponent<VelocityComponent>(e, {Vec2<float>(0.f, 0.f), pConfig.speed});
-        coordinator.AddComponent<CollisionComponent>(e, {pConfig.collisionRadius});
-        coordinator.AddComponent<HealthComponent>(e, {pConfig.pointCount, pConfig.pointCount}); // Initial health = point count
-        coordinator.AddComponent<ScoreComponent>(e, {0}); // Initial score
-        coordinator.AddComponent<WeaponComponent>(e, {true, true}); // Enable gun and sonar
-        coordinator.AddComponent<GunComponent>(e, {gunConfig.interval, gunConfig.interval, gunConfig.shapeRadius, gunConfig.speed, gunConfig.lifeSpan});
-        coordinator.AddComponent<SonarWeaponComponent>(e, { sConfig.interval, sConfig.timer, sConfig.power, sConfig.minRadius, sConfig.maxRadius, sConfig.lifeSpan });
-
         ShapeComponent shape;
         shape.shapeType         = ShapeType::Circle;
         shape.points            = pConfig.pointCount;
@@ -67,23 +54,30 @@ namespace EntityFactory
         shape.outlineThickness  = pConfig.outlineThickness;
         shape.originX           = pConfig.shapeRadius;
         shape.originY           = pConfig.shapeRadius;
-        coordinator.AddComponent<ShapeComponent>(e, shape);
 
         GlowComponent glow(shape);
         glow.radius += 1.f;
         glow.originX = glow.radius;
         glow.originY = glow.radius;
-        coordinator.AddComponent<GlowComponent>(e, glow);
-
-        LightAuraComponent aura;
-        coordinator.AddComponent<LightAuraComponent>(e, aura);
 
-        return e;
+        return coordinator.CreateEntityWith(
+            PlayerComponent{}, // Tag as player
+            TagComponent{EntityType::PLAYER}, // Add specific type tag
+            InputComponent{}, // Mark for input handling
+            TransformComponent{Vec2<float>(posX, posY), 0.f, 1.f, pConfig.rot},
+            VelocityComponent{Vec2<float>(0.f, 0.f), pConfig.speed},
+            CollisionComponent{pConfig.collisionRadius},
+            HealthComponent{pConfig.pointCount, pConfig.pointCount}, // Initial health = point count
+            ScoreComponent{0}, // Initial score
+            WeaponComponent{true, true}, // Enable gun and sonar
+            GunComponent{gunConfig.interval, gunConfig.interval, gunConfig.shapeRadius, gunConfig.speed, gunConfig.lifeSpan},
+            SonarWeaponComponent{sConfig.interval, sConfig.timer, sConfig.power, sConfig.minRadius, sConfig.maxRadius, sConfig.lifeSpan},
+            shape,
+            glow,
+            LightAuraComponent{});
     }
     ecs::Entity SpawnEnemy(sf::RenderWindow& window, ecs::Coordinator& coordinator, ecs::Entity player, bool isAdvanced)
     {
-        const ecs::Entity e = coordinator.CreateEntity();
-
         const auto& eConfig      = gConfig.GetGameConfig().enemy;
         const float windowWidth  = static_cast<float>(window.getSize().x);
         const float windowHeight = static_cast<float>(window.getSize().y);
@@ -119,13 +113,6 @@ namespace EntityFactory
         const float velX = std::cos(initialAngleRad) * speed;
         const float velY = std::sin(initialAngleRad) * speed;
 
-        coordinator.AddComponent<EnemyComponent>(e, {}); // Tag as enemy
-        coordinator.AddComponent<TagComponent>(e, {EntityType::ENEMY});
-        coordinator.AddComponent<TransformComponent>(e, {Vec2<float>(spawnX, spawnY), 0.f, 1.f, rot});
-        coordinator.AddComponent<VelocityComponent>(e, {Vec2<float>(velX, velY), speed});
-        coordinator.AddComponent<CollisionComponent>(e, {eConfig.collisionRadius});
-        coordinator.AddComponent<HealthComponent>(e, {pointCount, pointCount}); // Health = point count
-
         ShapeComponent shape;
         shape.shapeType         = ShapeType::Circle;
         shape.points            = pointCount;
@@ -137,7 +124,15 @@ namespace EntityFactory
         shape.outlineThickness  = eConfig.outlineThickness;
         shape.originX           = eConfig.shapeRadius;
         shape.originY           = eConfig.shapeRadius;
-        coordinator.AddComponent<ShapeComponent>(e, shape);
+
+        const ecs::Entity e = coordinator.CreateEntityWith(
+            EnemyComponent{}, // Tag as enemy
+            TagComponent{EntityType::ENEMY},
+            TransformComponent{Vec2<float>(spawnX, spawnY), 0.f, 1.f, rot},
+            VelocityComponent{Vec2<float>(velX, velY), speed},
+            CollisionComponent{eConfig.collisionRadius},
+            HealthComponent{pointCount, pointCount}, // Health = point count
+            shape);
 
         if (isAdvanced || pointCount == eConfig.pointCountMax)
         {
@@ -151,8 +146,6 @@ namespace EntityFactory
     }
     ecs::Entity SpawnBullet(ecs::Coordinator& coordinator, const ecs::Entity parent, const float targetX, const float targetY)
     {
-        const ecs::Entity e = coordinator.CreateEntity();
-
         const auto& parentPos = coordinator.GetComponent<TransformComponent>(parent).position;
         const auto& parentGun = coordinator.GetComponent<GunComponent>(parent);
         const auto& bConfig   = gConfig.GetGameConfig().bullet;
@@ -161,13 +154,6 @@ namespace EntityFactory
         velocityDir.Normalize();
         velocityDir *= parentGun.speed;
 
-        coordinator.AddComponent<BulletComponent>(e, {}); // Tag as bullet
-        coordinator.AddComponent<TagComponent>(e, {EntityType::BULLET});
-        coordinator.AddComponent<TransformComponent>(e, {parentPos}); // Initial position = parent's position
-        coordinator.AddComponent<VelocityComponent>(e, {velocityDir, parentGun.speed});
-        coordinator.AddComponent<CollisionComponent>(e, {parentGun.radius + bConfig.outlineThickness});
-        coordinator.AddComponent<LifespanComponent>(e, {parentGun.lifeSpan, parentGun.lifeSpan});
-
         ShapeComponent shape;
         shape.shapeType         = ShapeType::Circle;
         shape.points            = bConfig.pointCount;
@@ -177,51 +163,47 @@ namespace EntityFactory
         shape.outlineThickness  = bConfig.outlineThickness;
         shape.originX           = parentGun.radius;
         shape.originY           = parentGun.radius;
-        coordinator.AddComponent<ShapeComponent>(e, shape);
 
-        return e;
+        return coordinator.CreateEntityWith(
+            BulletComponent{}, // Tag as bullet
+            TagComponent{EntityType::BULLET},
+            TransformComponent{parentPos}, // Initial position = parent's position
+            VelocityComponent{velocityDir, parentGun.speed},
+            CollisionComponent{parentGun.radius + bConfig.outlineThickness},
+            LifespanComponent{parentGun.lifeSpan, parentGun.lifeSpan},
+            shape);
     }
     ecs::Entity SpawnSoundWave(ecs::Coordinator& coordinator, const ecs::Entity parent)
     {
-        const ecs::Entity e = coordinator.CreateEntity();
-
         const auto& parentPos   = coordinator.GetComponent<TransformComponent>(parent).position;
         const auto& parentSonar = coordinator.GetComponent<SonarWeaponComponent>(parent);
         const auto& sConfig     = gConfig.GetGameConfig().sonar;
 
-        coordinator.AddComponent<TransformComponent>(e, {parentPos}); // Initial position = parent
-        coordinator.AddComponent<LifespanComponent>(e, {parentSonar.lifeSpan, parentSonar.lifeSpan});
-        coordinator.AddComponent<TagComponent>(e, {EntityType::SOUNDWAVE});
-        coordinator.AddComponent<CollisionComponent>(e, {parentSonar.minRadius});  // Initial collision radius = min radius. Lifespan system will expand this.
-        coordinator.AddComponent<SoundWaveComponent>(e, { parentSonar.power, parentSonar.minRadius, parentSonar.maxRadius });
-
         ShapeComponent shape;
         shape.shapeType                     = ShapeType::Vertex;
         shape.vertexShapeData.color         = sConfig.color;
         shape.vertexShapeData.radius        = parentSonar.minRadius;
         shape.vertexShapeData.segments      = sConfig.segments;
-        coordinator.AddComponent<ShapeComponent>(e, shape);
 
-        return e;
+        return coordinator.CreateEntityWith(
+            TransformComponent{parentPos}, // Initial position = parent
+            LifespanComponent{parentSonar.lifeSpan, parentSonar.lifeSpan},
+            TagComponent{EntityType::SOUNDWAVE},
+            CollisionComponent{parentSonar.minRadius},  // Initial collision radius = min radius. Lifespan system will expand this.
+            SoundWaveComponent{parentSonar.power, parentSonar.minRadius, parentSonar.maxRadius},
+            shape);
     }
-    ecs::Entity SpawnParticle(ecs::Coordinator& coordinator, ecs::Entity parent, float angleDegrees, int previousHP)
+    std::size_t SpawnParticles(ecs::Coordinator& coordinator, ecs::Entity parent, int count, int previousHP)
     {
-        const ecs::Entity e = coordinator.CreateEntity();
+        if (count <= 0)
+        {
+            return 0;
+        }
 
         const auto& parentPos = coordinator.GetComponent<TransformComponent>(parent).position;
         const auto& partConfig = gConfig.GetGameConfig().particle;
         const auto& eConfig = gConfig.GetGameConfig().enemy;
 
-        const float angleRad = angleDegrees * (std::numbers::pi_v<float> / 180.f);
-        const float velX = std::cos(angleRad) * partConfig.speed;
-        const float velY = std::sin(angleRad) * partConfig.speed;
-
-        coordinator.AddComponent<ParticleComponent>(e, {}); // Tag as particle
-        coordinator.AddComponent<TagComponent>(e, {EntityType::PARTICLE});
-        coordinator.AddComponent<TransformComponent>(e, {parentPos, 0.f, 1.f, partConfig.rot});
-        coordinator.AddComponent<VelocityComponent>(e, {Vec2<float>(velX, velY), partConfig.speed});
-        coordinator.AddComponent<LifespanComponent>(e, {partConfig.lifeSpan, partConfig.lifeSpan});
-
         ShapeComponent shape;
         shape.shapeType         = ShapeType::Circle;
         shape.points            = std::max(3, previousHP);
@@ -233,9 +215,31 @@ namespace EntityFactory
         shape.outlineThickness  = partConfig.outlineThickness;
         shape.originX           = partConfig.shapeRadius;
         shape.originY           = partConfig.shapeRadius;
-        coordinator.AddComponent<ShapeComponent>(e, shape);
 
-        return e;
+        // Every particle of a burst starts out the same apart from its direction
+        const ecs::Prefab prefab = coordinator.CreatePrefab(
+            ParticleComponent{}, // Tag as particle
+            TagComponent{EntityType::PARTICLE},
+            TransformComponent{parentPos, 0.f, 1.f, partConfig.rot},
+            VelocityComponent{Vec2<float>(0.f, 0.f), partConfig.speed},
+            LifespanComponent{partConfig.lifeSpan, partConfig.lifeSpan},
+            shape);
+
+        std::vector<ecs::Entity> particles;
+        const std::size_t spawned = coordinator.Instantiate(prefab, static_cast<std::size_t>(count), particles);
+
+        // Spread the particles evenly around the parent
+        for (std::size_t i = 0; i < spawned; ++i)
+        {
+            const float angleDegrees = 360.f / static_cast<float>(count) * static_cast<float>(i + 1);
+            const float angleRad = angleDegrees * (std::numbers::pi_v<float> / 180.f);
+
+            auto& vel = coordinator.GetComponent<VelocityComponent>(particles[i]).vec;
+            vel.x = std::cos(angleRad) * partConfig.speed;
+            vel.y = std::sin(angleRad) * partConfig.speed;
+        }
+
+        return spawned;
     }
 
 } // namespace EntityFactory
\ No newline at end of file
@@ -8,6 +8,7 @@
 #ifndef ENTITYFACTORY_HPP
 #define ENTITYFACTORY_HPP
 
+#include <cstddef>
 #include <ecs/Coordinator.hpp>
 #include <ecs/Types.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
@@ -51,14 +52,18 @@ namespace EntityFactory
     ecs::Entity SpawnSoundWave(ecs::Coordinator& coordinator, ecs::Entity parent);
 
     /**
-     * @brief Creates a particle effect at the position of a parent entity.
+     * @brief Creates a burst of particles spreading out evenly from a parent entity.
+     *
+     * The particles are instantiated from one prefab, so the whole burst joins
+     * its systems in a single batch.
+     *
      * @param coordinator The ECS coordinator.
      * @param parent The entity to spawn particles around.
-     * @param angle The angle at which to emit the particle.
+     * @param count The number of particles.
      * @param previousHP The previous health value, used for visual styling.
-     * @return The created entity ID.
+     * @return The number of particles created.
      */
-    ecs::Entity SpawnParticle(ecs::Coordinator& coordinator, ecs::Entity parent, float angle, int previousHP);
+    std::size_t SpawnParticles(ecs::Coordinator& coordinator, ecs::Entity parent, int count, int previousHP);
 
 } // namespace EntityFactory
 
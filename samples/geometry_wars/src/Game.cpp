@@ -8,6 +8,11 @@
 
 #include "GameStates/MenuState.hpp"
 
+#include <ecs/Tracer.hpp>
+
+#include <fstream>
+#include <iostream>
+
 Game::Game(const std::string& configPath)
 : m_fpsCounter(0)
 , m_currentFps(0)
@@ -31,6 +36,7 @@ Game::Game(const std::string& configPath)
 void Game::Init()
 {
     m_coordinator.Init();
+    m_eventBus.SetJobSystem(m_coordinator.GetJobSystem()); // Systems may emit from the scheduler's workers
     GameInit::RegisterAllComponents(m_coordinator);
     GameInit::RegisterAllSystems(m_window, m_coordinator, m_eventBus);
 
@@ -40,15 +46,28 @@ void Game::Init()
 void Game::Run()
 {
     sf::Clock clock;
+    ecs::Tracer::SetThreadName("Main");
 
     while(m_window.isOpen())
     {
         ProcessEvents();
 
+        // The real frame time; the play state turns it into fixed simulation steps
         const float dt = clock.restart().asSeconds();
 
-        Update(dt);
-        Render(dt);
+        {
+            ECS_ZONE("Frame");
+            Update(dt);
+            Render(dt);
+        }
+
+        // A trace started with F3 covers a fixed number of frames and is written once they passed
+        if (ecs::Tracer::EndFrame())
+        {
+            std::ofstream file("geometry_wars_trace.json");
+            ecs::Tracer::WriteChromeTrace(file);
+            std::cout << "Wrote geometry_wars_trace.json, open it in https://ui.perfetto.dev\n";
+        }
     }
 }
 
@@ -3,6 +3,7 @@
  * @brief Implementation of the PlayState.
  */
 #include <ecs/Coordinator.hpp>
+#include <ecs/Tracer.hpp>
 
 #include "StateMachine.hpp"
 #include "PlayState.hpp"
@@ -30,6 +31,8 @@
 
 #include "Systems/RenderSystem.hpp"
 
+#include <iostream>
+
 PlayState::PlayState(StateMachine& machine, sf::RenderWindow& window, ecs::Coordinator& coordinator, ecs::EventBus& eventBus, sf::Font& font)
 : m_stateMachine(machine)
 , m_window(window)
@@ -44,6 +47,8 @@ PlayState::PlayState(StateMachine& machine, sf::RenderWindow& window, ecs::Coord
 , m_gameOver(false)
 , m_paused(false)
 , m_playerEntity(ecs::NullEntity)
+, m_scheduler(coordinator.GetJobSystem(), 1.f / 60.f, 5)
+, m_recordingStats(false)
 {
     m_listenerIDArr[0] = m_eventBus.AddListener<PlayerSpawnedEvent>(
         [this](const PlayerSpawnedEvent& event) {
@@ -79,6 +84,38 @@ PlayState::PlayState(StateMachine& machine, sf::RenderWindow& window, ecs::Coord
     m_scoreText.setCharacterSize(18);
     m_scoreText.setFillColor(sf::Color(176, 161, 28, 255));
 
+    // Within a phase systems are listed in their single-threaded order; the ones that share no data run in parallel.
+    // Input and Render run once per frame, the rest once per fixed step.
+    using ecs::Phase;
+    const auto sync = [this](float)
+    {
+        m_eventBus.ProcessEvents();
+        m_coordinator.PlaybackCommands();
+    };
+
+    m_scheduler.Add(Phase::Input,   "Input",         m_coordinator.GetSystem<InputSystem>());
+    m_scheduler.Add(Phase::PreSim,  "EnemySpawn",    m_coordinator.GetSystem<EnemySpawnSystem>());
+    m_scheduler.Add(Phase::Sim,     "Weapon",        m_coordinator.GetSystem<WeaponSystem>());
+    m_scheduler.Add(Phase::Sim,     "AdvancedEnemy", m_coordinator.GetSystem<AdvancedEnemySystem>());
+    m_scheduler.Add(Phase::Sim,     "Movement",      m_coordinator.GetSystem<MovementSystem>());
+    m_scheduler.Add(Phase::Sim,     "Boundary",      m_coordinator.GetSystem<BoundarySystem>());
+    m_scheduler.Add(Phase::Sim,     "Collision",     m_coordinator.GetSystem<CollisionSystem>());
+    m_scheduler.Add(Phase::PostSim, "ProcessEvents", [this](float) { m_eventBus.ProcessEvents(); }, ecs::SystemAccess().Exclusive());
+    m_scheduler.Add(Phase::PostSim, "Health",        m_coordinator.GetSystem<HealthSystem>());
+    m_scheduler.Add(Phase::PostSim, "Lifespan",      m_coordinator.GetSystem<LifespanSystem>());
+    m_scheduler.Add(Phase::PostSim, "Particle",      m_coordinator.GetSystem<ParticleSystem>());
+    m_scheduler.Add(Phase::PostSim, "Sync",          sync, ecs::SystemAccess().Exclusive());
+    m_scheduler.Add(Phase::Render,  "Render",        m_coordinator.GetSystem<RenderSystem>());
+
+    // Collision tests every pair of nearby bodies; flag steps where it eats a quarter of the 16 ms step
+    m_coordinator.SetSystemBudget<CollisionSystem>(std::chrono::milliseconds(4));
+    m_coordinator.SetBudgetOverrunCallback(
+        [](const std::string& name, const std::chrono::nanoseconds elapsed, const std::chrono::nanoseconds budget)
+        {
+            std::cerr << name << " took " << elapsed.count() / 1000 << " us, budget "
+                      << budget.count() / 1000 << " us\n";
+        });
+
     m_coordinator.DestroyAllEntities();
     m_eventBus.Emit<SpawnPlayerEvent>({}, true);
 }
@@ -99,6 +136,11 @@ void PlayState::OnExit()
     m_eventBus.RemoveListener<PlayerDeadEvent>(m_listenerIDArr[1]);
     m_eventBus.RemoveListener<ScoredEvent>(m_listenerIDArr[2]);
     m_coordinator.DestroyAllEntities();
+    if (m_recordingStats)
+    {
+        m_coordinator.DisableSystemStats();
+        m_recordingStats = false;
+    }
 }
 
 void PlayState::HandleEvent(sf::Event &event)
@@ -110,9 +152,47 @@ void PlayState::HandleEvent(sf::Event &event)
 
         if(event.key.code == sf::Keyboard::Escape)
             m_eventBus.Emit<PlayerDeadEvent>({m_playerEntity});
+
+        if(event.key.code == sf::Keyboard::F1)
+            m_scheduler.DumpSchedule(std::cout);
+
+        if(event.key.code == sf::Keyboard::F2)
+            ToggleSystemStats();
+
+        if(event.key.code == sf::Keyboard::F3 && !ecs::Tracer::IsRecording())
+        {
+            ecs::Tracer::Start(120);
+            std::cout << "Tracing the next 120 frames\n";
+        }
     }
 }
 
+void PlayState::ToggleSystemStats()
+{
+    m_recordingStats = !m_recordingStats;
+    if (m_recordingStats)
+    {
+        m_coordinator.EnableSystemStats(240);
+        std::cout << "Recording system statistics, press F2 again to print them\n";
+        return;
+    }
+
+    std::cout << "System statistics over the last updates (us): mean / p50 / p99 / max, entities, changes, events\n";
+    for (const ecs::SystemStats& stats : m_coordinator.GetSystemStats())
+    {
+        std::cout << "  " << stats.name << " x" << stats.updates << ": "
+                  << stats.mean.count() / 1000 << " / " << stats.p50.count() / 1000 << " / "
+                  << stats.p99.count() / 1000 << " / " << stats.max.count() / 1000 << ", "
+                  << stats.entities << ", " << stats.structuralChanges << ", " << stats.eventsEmitted;
+        if (stats.overruns > 0)
+        {
+            std::cout << ", " << stats.overruns << " over budget";
+        }
+        std::cout << '\n';
+    }
+    m_coordinator.DisableSystemStats();
+}
+
 void PlayState::Update(const float dt)
 {
     m_elapsedTime += dt;
@@ -127,36 +207,15 @@ void PlayState::Update(const float dt)
             static_cast<int>(m_window.getSize().x), static_cast<int>(m_window.getSize().y)));
     }
 
-    auto sInput         = m_coordinator.GetSystem<InputSystem>();
-    auto sWeapon        = m_coordinator.GetSystem<WeaponSystem>();
-    auto sEnemySpawn    = m_coordinator.GetSystem<EnemySpawnSystem>();
-    auto sAdvancedEnemy = m_coordinator.GetSystem<AdvancedEnemySystem>();
-    auto sMovement      = m_coordinator.GetSystem<MovementSystem>();
-    auto sBoundary      = m_coordinator.GetSystem<BoundarySystem>();
-    auto sCollision     = m_coordinator.GetSystem<CollisionSystem>();
-    auto sHealth        = m_coordinator.GetSystem<HealthSystem>();
-    auto sLifespan      = m_coordinator.GetSystem<LifespanSystem>();
-    auto sParticle      = m_coordinator.GetSystem<ParticleSystem>();
-
+    // The simulation steps at a fixed rate however long the frame took; events and commands from
+    // HandleEvent, or from frames without a step, are still applied below
     if(!m_paused && !m_gameOver)
     {
-        sInput->Update(dt);
-        sWeapon->Update(dt);
-        sEnemySpawn->Update(dt);
-        sAdvancedEnemy->Update(dt);
-        sMovement->Update(dt);
-        sBoundary->Update(dt);
-        sCollision->Update(dt);
-
-        m_eventBus.ProcessEvents(); // *** PROCESS SYNC EVENTS ***
-
-        sHealth->Update(dt);
-        sLifespan->Update(dt);
-        sParticle->Update(dt);
+        m_scheduler.Update(dt);
     }
 
     m_eventBus.ProcessEvents();
-    m_coordinator.DestroyQueuedEntities();
+    m_coordinator.PlaybackCommands();
 
     if (m_gameOver)
     {
@@ -170,8 +229,8 @@ void PlayState::Render(const float dt, sf::RenderWindow &window)
     m_window.draw(m_background);
     m_window.draw(m_blackOverlay);
 
-    auto sRender = m_coordinator.GetSystem<RenderSystem>();
-    sRender->Update(dt);
+    m_coordinator.GetSystem<RenderSystem>()->SetAlpha(m_scheduler.GetAlpha());
+    m_scheduler.Render(dt);
 
     float winWidth = static_cast<float>(m_window.getSize().x);
     m_scoreText.setString("Score: " + std::to_string(m_score));
@@ -11,6 +11,7 @@
 #include <SFML/Graphics.hpp>
 #include <ecs/Coordinator.hpp>
 #include <ecs/EventBus.hpp>
+#include <ecs/PhaseScheduler.hpp>
 
 #include "State.hpp"
 
@@ -44,6 +45,11 @@ public:
     void Render(float dt, sf::RenderWindow& window) override;
 
 private:
+    /**
+     * @brief Starts recording system statistics, or prints and stops them if they are being recorded.
+     */
+    void ToggleSystemStats();
+
     StateMachine&       m_stateMachine;      // Reference to the state machine
     sf::RenderWindow&   m_window;            // Reference to the SFML window
     ecs::Coordinator&   m_coordinator;       // Reference to the ECS coordinator
@@ -61,6 +67,8 @@ private:
     bool                m_gameOver;          // Flag indicating game over
     bool                m_paused;            // Flag indicating pause state
     ecs::Entity         m_playerEntity;      // Reference to the player entity
+    ecs::PhaseScheduler m_scheduler;         // Runs the gameplay systems in phases at a fixed 60 Hz tick
+    bool                m_recordingStats;    // Whether system statistics are being recorded
 
     std::array<ecs::ListenerID, 3> m_listenerIDArr {};  // Event listener IDs
 };
@@ -24,6 +24,13 @@ AdvancedEnemySystem::AdvancedEnemySystem(sf::RenderWindow& window, ecs::Coordina
 , m_chaseWeight(.2f)
 , m_avoidWeight(.8f)
 {
+    m_access.Read<AdvancedEnemyComponent, TransformComponent, CollisionComponent, BulletComponent>()
+            .Write<VelocityComponent>()
+            .Listen<PlayerSpawnedEvent, PlayerDeadEvent>();
+
+    // The bullet-threat scan is the most expensive loop of the frame; steering at 20 Hz still looks responsive
+    SetUpdateRate(20.f);
+
     // Listen for player spawn events to track the player entity
     m_eventBus.AddListener<PlayerSpawnedEvent>(
         [this](const PlayerSpawnedEvent& ev) {
@@ -41,13 +48,14 @@ AdvancedEnemySystem::AdvancedEnemySystem(sf::RenderWindow& window, ecs::Coordina
 
 void AdvancedEnemySystem::Update(float dt)
 {
-    // Don't process if there's no player
-    if (m_playerEntity == ecs::NullEntity)
+    // Don't process if there's no player (the handle goes stale once the player is destroyed)
+    if (!m_coordinator.IsEntityAlive(m_playerEntity))
         return;
 
     const auto& playerPos = m_coordinator.GetComponent<TransformComponent>(m_playerEntity).position;
 
-    for (auto [e, _] : m_entities)
+    // Enemies only write their own velocity, so they are steered in parallel
+    ParallelEach(16, [&](const ecs::Entity e)
     {
         auto& eAdv = m_coordinator.GetComponent<AdvancedEnemyComponent>(e);
         auto& ePos = m_coordinator.GetComponent<TransformComponent>(e).position;
@@ -55,8 +63,9 @@ void AdvancedEnemySystem::Update(float dt)
         auto& eCol = m_coordinator.GetComponent<CollisionComponent>(e);
 
         // Default behavior: chase the player
-        m_chaseDir = (playerPos - ePos).Normalized();
+        const Vec2<float> chaseDir = (playerPos - ePos).Normalized();
 
+        Vec2<float> bulletPos;
         bool shouldEvade = false;
         float finalSpeed = eAdv.chaseSpeed;
 
@@ -70,16 +79,16 @@ void AdvancedEnemySystem::Update(float dt)
             auto& bVel = m_coordinator.GetComponent<VelocityComponent>(bulletEntity).vec;
             auto& bCol = m_coordinator.GetComponent<CollisionComponent>(bulletEntity);
 
-            m_bulletToEnemy = bPos - ePos;
+            const Vec2<float> bulletToEnemy = bPos - ePos;
 
             // Skip bullets that are too far away
-            if (m_bulletToEnemy.LengthSquared() > eAdv.evadeThreshold * eAdv.evadeThreshold)
+            if (bulletToEnemy.LengthSquared() > eAdv.evadeThreshold * eAdv.evadeThreshold)
                 continue;
 
             // Bullet trajectory analysis
             // Calculate if the bullet is moving toward the enemy
             float bVelDotVel = bVel.x * bVel.x + bVel.y * bVel.y;
-            float bulletToEnemyDotVel = m_bulletToEnemy.x * bVel.x + m_bulletToEnemy.y * bVel.y;
+            float bulletToEnemyDotVel = bulletToEnemy.x * bVel.x + bulletToEnemy.y * bVel.y;
 
             // Skip if bullet is stationary or moving away from enemy
             if (bVelDotVel <= 0.0001f || bulletToEnemyDotVel > 0.f)
@@ -92,7 +101,7 @@ void AdvancedEnemySystem::Update(float dt)
                 continue;  // Closest approach already happened
 
             // Calculate position of closest approach
-            auto closestPoint = m_bulletToEnemy + (bVel * tStar);
+            auto closestPoint = bulletToEnemy + (bVel * tStar);
 
             // Check if this closest approach would result in a collision
             float collisionDist = eCol.radius + bCol.radius;
@@ -100,33 +109,34 @@ void AdvancedEnemySystem::Update(float dt)
             {
                 // Bullet will hit enemy, trigger evasion
                 shouldEvade = true;
-                m_bulletPos = bPos;
+                bulletPos = bPos;
                 break;
             }
         }
 
+        Vec2<float> avoidDir;
         if (shouldEvade)
         {
             // Calculate evasion direction - perpendicular to bullet path
-            Vec2<float> toBullet = m_bulletPos - ePos;
-            float cross = m_chaseDir.x * toBullet.y - m_chaseDir.y * toBullet.x;
-            m_avoidDir = toBullet.Normalized();
+            Vec2<float> toBullet = bulletPos - ePos;
+            float cross = chaseDir.x * toBullet.y - chaseDir.y * toBullet.x;
+            avoidDir = toBullet.Normalized();
 
             // Choose direction based on cross product to ensure enemy doesn't move into bullet
-            m_avoidDir.RotateDegrees((cross > 0.f) ? -90.f : 90.f);
+            avoidDir.RotateDegrees((cross > 0.f) ? -90.f : 90.f);
             finalSpeed = eAdv.evadeSpeed;  // Move faster when evading
         }
         else
         {
-            m_avoidDir = {0.f, 0.f};  // No evasion needed
+            avoidDir = {0.f, 0.f};  // No evasion needed
         }
 
         // Combine chase and avoid vectors with their weights
-        m_finalDir = (m_chaseDir * m_chaseWeight) + (m_avoidDir * m_avoidWeight);
-        m_finalDir.Normalize();
-        m_finalDir *= finalSpeed;
+        Vec2<float> finalDir = (chaseDir * m_chaseWeight) + (avoidDir * m_avoidWeight);
+        finalDir.Normalize();
+        finalDir *= finalSpeed;
 
         // Update enemy velocity
-        eVel = m_finalDir;
-    }
+        eVel = finalDir;
+    });
 }
\ No newline at end of file
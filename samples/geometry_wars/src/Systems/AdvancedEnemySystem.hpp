@@ -36,11 +36,6 @@ private:
     ecs::Coordinator& m_coordinator;  // Reference to the ECS coordinator
     ecs::EventBus&    m_eventBus;     // Reference to the event bus
     ecs::Entity       m_playerEntity;  // Reference to the player entity
-    Vec2<float>       m_chaseDir;     // Direction vector towards player
-    Vec2<float>       m_avoidDir;     // Direction vector away from bullets
-    Vec2<float>       m_finalDir;     // Final direction after combining chase and avoid
-    Vec2<float>       m_bulletToEnemy;  // Vector from bullet to enemy
-    Vec2<float>       m_bulletPos;    // Position of the nearest threatening bullet
     float             m_chaseWeight;   // Weight for chasing behavior
     float             m_avoidWeight;   // Weight for avoidance behavior
 };
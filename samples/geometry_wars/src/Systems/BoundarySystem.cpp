@@ -14,15 +14,17 @@ BoundarySystem::BoundarySystem(sf::RenderWindow &window, ecs::Coordinator &coord
 : m_window(window)
 , m_coordinator(coordinator)
 {
+    m_access.Read<ShapeComponent, BulletComponent, EnemyComponent>()
+            .Write<TransformComponent, VelocityComponent>();
 }
 
 void BoundarySystem::Update(float dt)
 {
-    for (auto [e, _] : m_entities)
-        BounceIfOutside(e);
+    // Each entity only touches its own components, so the set is processed in parallel
+    ParallelEach(256, [this](const ecs::Entity e, ecs::CommandBuffer& commands) { BounceIfOutside(e, commands); });
 }
 
-void BoundarySystem::BounceIfOutside(const ecs::Entity e) const
+void BoundarySystem::BounceIfOutside(const ecs::Entity e, ecs::CommandBuffer& commands) const
 {
     auto& pos   = m_coordinator.GetComponent<TransformComponent>(e).position;
     auto& shape = m_coordinator.GetComponent<ShapeComponent>(e);
@@ -41,7 +43,7 @@ void BoundarySystem::BounceIfOutside(const ecs::Entity e) const
     {
         if(hasBullet)
         {
-            m_coordinator.DestroyEntity(e);
+            commands.DestroyEntity(e);
             return;
         }
 
@@ -55,7 +57,7 @@ void BoundarySystem::BounceIfOutside(const ecs::Entity e) const
     {
         if(hasBullet)
         {
-            m_coordinator.DestroyEntity(e);
+            commands.DestroyEntity(e);
             return;
         }
 
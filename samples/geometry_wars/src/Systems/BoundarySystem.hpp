@@ -35,8 +35,9 @@ private:
     /**
      * @brief Handles boundary interactions for a specific entity.
      * @param entity The entity to check.
+     * @param commands Command buffer of the thread, for destroying bullets that left the screen.
      */
-    void BounceIfOutside(ecs::Entity entity) const;
+    void BounceIfOutside(ecs::Entity entity, ecs::CommandBuffer& commands) const;
 };
 
 #endif //BOUNDARYSYSTEM_HPP
\ No newline at end of file
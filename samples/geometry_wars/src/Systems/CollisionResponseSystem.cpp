@@ -4,6 +4,10 @@
  */
 #include "CollisionResponseSystem.hpp"
 
+#include <algorithm>
+#include <tuple>
+#include <utility>
+
 #include "Core/Math/Vec2.hpp"
 
 #include <ecs/Coordinator.hpp>
@@ -25,9 +29,10 @@ CollisionResponseSystem::CollisionResponseSystem(sf::RenderWindow& window, ecs::
 , m_coordinator(coordinator)
 , m_eventBus(eventBus)
 {
-    m_eventBus.AddListener<CollisionEvent>(
-        [this](const CollisionEvent &ev) {
-            OnCollision(ev);
+    // Collisions are the most frequent event; the whole frame's collisions arrive in one call
+    m_eventBus.AddBatchListener<CollisionEvent>(
+        [this](const std::span<const CollisionEvent> events) {
+            OnCollisions(events);
         }
     );
 }
@@ -36,36 +41,86 @@ void CollisionResponseSystem::Update(const float dt)
 {
 }
 
-void CollisionResponseSystem::OnCollision(CollisionEvent event)
+void CollisionResponseSystem::OnCollisions(const std::span<const CollisionEvent> events)
+{
+    // Each pair once, lower entity first, so a pair reported twice or in either order is handled once
+    m_pairs.assign(events.begin(), events.end());
+    for (CollisionEvent& pair : m_pairs)
+        if (pair.entity2 < pair.entity1) std::swap(pair.entity1, pair.entity2);
+
+    std::sort(m_pairs.begin(), m_pairs.end(), [](const CollisionEvent& a, const CollisionEvent& b) {
+        return std::tie(a.entity1, a.entity2) < std::tie(b.entity1, b.entity2);
+    });
+    m_pairs.erase(std::unique(m_pairs.begin(), m_pairs.end(), [](const CollisionEvent& a, const CollisionEvent& b) {
+        return a.entity1 == b.entity1 && a.entity2 == b.entity2;
+    }), m_pairs.end());
+
+    // Resolve each distinct entity once. An earlier batch may have destroyed it, which a stale handle shows.
+    m_entities.clear();
+    for (const CollisionEvent& pair : m_pairs)
+    {
+        m_entities.push_back({pair.entity1, EntityType::PLAYER, false});
+        m_entities.push_back({pair.entity2, EntityType::PLAYER, false});
+    }
+    const auto byEntity = [](const BatchEntity& a, const BatchEntity& b) { return a.entity < b.entity; };
+    std::sort(m_entities.begin(), m_entities.end(), byEntity);
+    m_entities.erase(std::unique(m_entities.begin(), m_entities.end(), [](const BatchEntity& a, const BatchEntity& b) {
+        return a.entity == b.entity;
+    }), m_entities.end());
+
+    for (BatchEntity& entry : m_entities)
+    {
+        entry.consumed = !m_coordinator.IsEntityAlive(entry.entity);
+        if (!entry.consumed)
+            entry.type = m_coordinator.GetComponent<TagComponent>(entry.entity).type;
+    }
+
+    for (const CollisionEvent& pair : m_pairs)
+    {
+        BatchEntity& first  = FindBatchEntity(pair.entity1);
+        BatchEntity& second = FindBatchEntity(pair.entity2);
+        if (!first.consumed && !second.consumed)
+            OnCollision(first, second);
+    }
+}
+
+void CollisionResponseSystem::OnCollision(BatchEntity& first, BatchEntity& second)
 {
-    auto type1 = m_coordinator.GetComponent<TagComponent>(event.entity1).type;
-    auto type2 = m_coordinator.GetComponent<TagComponent>(event.entity2).type;
+    BatchEntity* a = &first;
+    BatchEntity* b = &second;
+
+    // Checks for a pair of the two types, putting the entity of the first type in a
+    const auto match = [&a, &b](const EntityType typeA, const EntityType typeB) {
+        if (a->type == typeB && b->type == typeA) std::swap(a, b);
+        return a->type == typeA && b->type == typeB;
+    };
 
-    if ((type1 == EntityType::PLAYER && type2 == EntityType::ENEMY) ||
-        (type1 == EntityType::ENEMY && type2 == EntityType::PLAYER))
+    if (match(EntityType::PLAYER, EntityType::ENEMY))
     {
-        if (type1 != EntityType::PLAYER) std::swap(event.entity1, event.entity2);
-        HandlePlayerEnemyCollision(event);
+        HandlePlayerEnemyCollision({a->entity, b->entity});
     }
-    else if ((type1 == EntityType::BULLET && type2 == EntityType::ENEMY) ||
-             (type1 == EntityType::ENEMY && type2 == EntityType::BULLET))
+    else if (match(EntityType::BULLET, EntityType::ENEMY))
     {
-        if (type1 != EntityType::BULLET) std::swap(event.entity1, event.entity2);
-        HandleBulletEnemyCollision(event);
+        HandleBulletEnemyCollision({a->entity, b->entity});
+        a->consumed = true;
     }
-    else if ((type1 == EntityType::SOUNDWAVE && type2 == EntityType::ENEMY) ||
-             (type1 == EntityType::ENEMY && type2 == EntityType::SOUNDWAVE))
+    else if (match(EntityType::SOUNDWAVE, EntityType::ENEMY))
     {
-        if (type1 != EntityType::SOUNDWAVE) std::swap(event.entity1, event.entity2);
-        HandleSoundWaveEnemyCollision(event);
+        HandleSoundWaveEnemyCollision({a->entity, b->entity});
     }
-    else if (type1 == EntityType::ENEMY && type2 == EntityType::ENEMY &&
-             (m_coordinator.HasComponent<AdvancedEnemyComponent>(event.entity1) || m_coordinator.HasComponent<AdvancedEnemyComponent>(event.entity2)))
+    else if (match(EntityType::ENEMY, EntityType::ENEMY) &&
+             (m_coordinator.HasComponent<AdvancedEnemyComponent>(a->entity) || m_coordinator.HasComponent<AdvancedEnemyComponent>(b->entity)))
     {
-        HandleEnemyEnemyCollision(event);
+        HandleEnemyEnemyCollision({a->entity, b->entity});
     }
 }
 
+CollisionResponseSystem::BatchEntity& CollisionResponseSystem::FindBatchEntity(const ecs::Entity entity)
+{
+    return *std::lower_bound(m_entities.begin(), m_entities.end(), entity,
+        [](const BatchEntity& entry, const ecs::Entity value) { return entry.entity < value; });
+}
+
 void CollisionResponseSystem::HandlePlayerEnemyCollision(const CollisionEvent &event)
 {
     ecs::Entity player = event.entity1;
@@ -73,31 +128,27 @@ void CollisionResponseSystem::HandlePlayerEnemyCollision(const CollisionEvent &e
 
     int playerHealtChangeAmount = -1;
     int enemyHealtChangeAmount  = -1;
-    if (m_coordinator.IsEntityAlive(player) && !m_coordinator.HasComponent<HealthChangeComponent>(player)) {
+    if (!m_coordinator.HasComponent<HealthChangeComponent>(player)) {
         m_coordinator.AddComponent<HealthChangeComponent>(player, {playerHealtChangeAmount});
     }
-    if (m_coordinator.IsEntityAlive(enemy) && !m_coordinator.HasComponent<HealthChangeComponent>(enemy)) {
+    if (!m_coordinator.HasComponent<HealthChangeComponent>(enemy)) {
         m_coordinator.AddComponent<HealthChangeComponent>(enemy, {enemyHealtChangeAmount});
     }
-    if (m_coordinator.IsEntityAlive(player) && m_coordinator.IsEntityAlive(enemy)) {
-        auto& pPos = m_coordinator.GetComponent<TransformComponent>(player).position;
-        auto& ePos = m_coordinator.GetComponent<TransformComponent>(enemy).position;
-        auto& eVel = m_coordinator.GetComponent<VelocityComponent>(enemy);
-        auto& eCol = m_coordinator.GetComponent<CollisionComponent>(enemy);
-
-        Vec2<float> dir = (ePos - pPos).Normalized();
-        eVel.vec = dir * eVel.speed;
-        ePos    += dir * (eCol.radius * 0.5f);
-    }
+
+    auto& pPos = m_coordinator.GetComponent<TransformComponent>(player).position;
+    auto& ePos = m_coordinator.GetComponent<TransformComponent>(enemy).position;
+    auto& eVel = m_coordinator.GetComponent<VelocityComponent>(enemy);
+    auto& eCol = m_coordinator.GetComponent<CollisionComponent>(enemy);
+
+    Vec2<float> dir = (ePos - pPos).Normalized();
+    eVel.vec = dir * eVel.speed;
+    ePos    += dir * (eCol.radius * 0.5f);
 }
 
 void CollisionResponseSystem::HandleBulletEnemyCollision(const CollisionEvent &event)
 {
     ecs::Entity bullet = event.entity1;
     ecs::Entity enemy  = event.entity2;
-    if (!m_coordinator.IsEntityAlive(bullet) || !m_coordinator.IsEntityAlive(enemy)) {
-        return;
-    }
 
     int enemyHeathChangeAmount = -1;
     if (!m_coordinator.HasComponent<HealthChangeComponent>(enemy))
@@ -109,7 +160,6 @@ void CollisionResponseSystem::HandleBulletEnemyCollision(const CollisionEvent &e
 
 void CollisionResponseSystem::HandleSoundWaveEnemyCollision(const CollisionEvent &event)
 {
-    if (!m_coordinator.IsEntityAlive(event.entity1) || !m_coordinator.IsEntityAlive(event.entity2)) return;
     auto& sPos = m_coordinator.GetComponent<TransformComponent>(event.entity1).position;
     auto& sWave = m_coordinator.GetComponent<SoundWaveComponent>(event.entity1);
     auto& ePos = m_coordinator.GetComponent<TransformComponent>(event.entity2).position;
@@ -122,7 +172,6 @@ void CollisionResponseSystem::HandleSoundWaveEnemyCollision(const CollisionEvent
 
 void CollisionResponseSystem::HandleEnemyEnemyCollision(const CollisionEvent &event)
 {
-     if (!m_coordinator.IsEntityAlive(event.entity1) || !m_coordinator.IsEntityAlive(event.entity2)) return;
     auto& e1Pos = m_coordinator.GetComponent<TransformComponent>(event.entity1).position;
     auto& e1Vel = m_coordinator.GetComponent<VelocityComponent>(event.entity1);
     auto e1CR = m_coordinator.GetComponent<CollisionComponent>(event.entity1).radius;
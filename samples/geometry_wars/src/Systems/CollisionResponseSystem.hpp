@@ -12,6 +12,9 @@
 #include <ecs/EventBus.hpp>
 #include <ecs/System.hpp>
 #include <SFML/Graphics.hpp>
+#include <span>
+#include <vector>
+#include "Components/TagComponent.hpp"
 #include "Events/CollisionEvent.hpp"
 
 class CollisionResponseSystem final : public ecs::System
@@ -32,15 +35,46 @@ public:
     void Update(float dt) override;
 
 private:
+    // An entity taking part in the collisions of a batch
+    struct BatchEntity
+    {
+        ecs::Entity entity;    // The entity
+        EntityType  type;      // Its tag, resolved once per batch
+        bool        consumed;  // Set once it was destroyed, by an earlier batch or by a collision of this one
+    };
+
     sf::RenderWindow& m_window;      // Reference to the SFML window
     ecs::Coordinator& m_coordinator;  // Reference to the ECS coordinator
     ecs::EventBus&    m_eventBus;     // Reference to the event bus
 
+    std::vector<CollisionEvent> m_pairs;     // Distinct pairs of the batch, lower entity first, sorted
+    std::vector<BatchEntity>    m_entities;  // Distinct entities of the batch, sorted
+
     /**
-     * @brief Event handler for collision events.
-     * @param event The collision event.
+     * @brief Batch handler for the collision events of a frame.
+     *
+     * Each pair is handled once, whichever order the broad phase reported its
+     * entities in, and each entity's tag is resolved once. A bullet destroyed
+     * by one collision takes part in no further collision of the batch, since
+     * the destruction itself is deferred.
+     *
+     * @param events The collision events, in emission order.
+     */
+    void OnCollisions(std::span<const CollisionEvent> events);
+
+    /**
+     * @brief Handles the collision of two entities of the batch.
+     * @param first The entity with the lower ID.
+     * @param second The other entity.
+     */
+    void OnCollision(BatchEntity& first, BatchEntity& second);
+
+    /**
+     * @brief Finds an entity of the batch being handled.
+     * @param entity The entity, which must take part in a pair of the batch.
+     * @return Its entry in m_entities.
      */
-    void OnCollision(CollisionEvent event);
+    BatchEntity& FindBatchEntity(ecs::Entity entity);
     
     /**
      * @brief Handles collision between player and enemy entities.
@@ -4,6 +4,8 @@
  */
 #include "CollisionSystem.hpp"
 
+#include <algorithm>
+
 #include <Components/EnemyComponent.hpp>
 
 #include "Core/Math//Vec2.hpp"
@@ -15,45 +17,50 @@
 CollisionSystem::CollisionSystem(ecs::Coordinator& coordinator, ecs::EventBus &eventBus)
 : m_coordinator(coordinator)
 , m_eventBus(eventBus)
+, m_transforms(coordinator.GetComponentArray<TransformComponent>())
+, m_collisions(coordinator.GetComponentArray<CollisionComponent>())
+, m_enemyType(coordinator.GetComponentTypeID<EnemyComponent>())
+, m_hits(coordinator.GetJobSystem())
 {
+    m_access.Read<TransformComponent, CollisionComponent, EnemyComponent>()
+            .Emit<CollisionEvent>();
 }
 
 void CollisionSystem::Update(float dt)
 {
-    m_collisionBuffer.clear();
     auto& list   = m_entities.GetDataVector();
     size_t count = m_entities.Size();
 
-    for(size_t i = 0; i < count; i++)
+    // Rows of the pair triangle get shorter, so small chunks keep the threads evenly loaded
+    m_coordinator.GetJobSystem().ParallelFor(0, count, 16, [&](const size_t begin, const size_t end)
     {
-        ecs::Entity eX = list[i];
-        if(!m_coordinator.IsEntityAlive(eX))
-            continue;
+        auto& hits = m_hits.Local();
+        for(size_t i = begin; i < end; i++)
+        {
+            ecs::Entity eX = list[i];
+            auto& xPos      = m_transforms.GetData(eX).position;
+            auto& xCol      = m_collisions.GetData(eX);
+            bool isExEnemy  = m_coordinator.GetSignature(eX).test(m_enemyType);
 
-        auto& xPos      = m_coordinator.GetComponent<TransformComponent>(eX).position;
-        auto& xCol      = m_coordinator.GetComponent<CollisionComponent>(eX);
-        bool isExEnemy  = m_coordinator.HasComponent<EnemyComponent>(eX);
+            for(size_t j = i+1; j < count; j++)
+            {
+                ecs::Entity eY = list[j];
+                if(!isExEnemy && !m_coordinator.GetSignature(eY).test(m_enemyType))
+                    continue;
 
-        for(size_t j = i+1; j < count; j++)
-        {
-            ecs::Entity eY = list[j];
-            if(!m_coordinator.IsEntityAlive(eY))
-                continue;
-            if(!isExEnemy && !m_coordinator.HasComponent<EnemyComponent>(eY))
-                continue;
-
-            if(CheckCollision(xPos, xCol, eY))
-                m_collisionBuffer.emplace_back(eX, eY);
+                if(CheckCollision(xPos, xCol, eY))
+                    hits.emplace_back(i, j);
+            }
         }
-    }
+    });
 
     DispatchCollisions();
 }
 
 bool CollisionSystem::CheckCollision(auto& position, auto& collision, const ecs::Entity entity)
 {
-    auto& yPos = m_coordinator.GetComponent<TransformComponent>(entity).position;
-    auto& yCol = m_coordinator.GetComponent<CollisionComponent>(entity);
+    auto& yPos = m_transforms.GetData(entity).position;
+    auto& yCol = m_collisions.GetData(entity);
 
     float dx    = position.x - yPos.x;
     float dy    = position.y - yPos.y;
@@ -65,8 +72,21 @@ bool CollisionSystem::CheckCollision(auto& position, auto& collision, const ecs:
 
 void CollisionSystem::DispatchCollisions()
 {
+    // Sorting the pairs restores the order a single thread would find them in
+    m_pairs.clear();
+    m_hits.ForEach([this](std::vector<std::pair<size_t, size_t>>& hits)
+    {
+        m_pairs.insert(m_pairs.end(), hits.begin(), hits.end());
+        hits.clear();
+    });
+    std::sort(m_pairs.begin(), m_pairs.end());
+
+    auto& list = m_entities.GetDataVector();
+    for(const auto& [i, j] : m_pairs)
+        m_collisionBuffer.emplace_back(list[i], list[j]);
+
     for(const auto &ev : m_collisionBuffer)
         m_eventBus.Emit<CollisionEvent>(ev);
 
     m_collisionBuffer.clear();
-}
\ No newline at end of file
+}
@@ -10,7 +10,11 @@
 
 #include <ecs/Coordinator.hpp>
 #include <ecs/EventBus.hpp>
+#include <ecs/PerThread.hpp>
 #include <ecs/System.hpp>
+#include "Components/CollisionComponent.hpp"
+#include "Components/EnemyComponent.hpp"
+#include "Components/TransformComponent.hpp"
 #include "Events/CollisionEvent.hpp"
 
 class CollisionSystem final : public ecs::System
@@ -34,6 +38,12 @@ private:
     ecs::EventBus&              m_eventBus;        // Reference to the event bus
     std::vector<CollisionEvent> m_collisionBuffer;  // Buffer to store collision events before dispatching
 
+    ecs::ComponentArray<TransformComponent>& m_transforms;  // Cached transform storage
+    ecs::ComponentArray<CollisionComponent>& m_collisions;  // Cached collision storage
+    ecs::ComponentTypeID                     m_enemyType;   // Bit of the enemy tag in entity signatures
+    ecs::PerThread<std::vector<std::pair<size_t, size_t>>> m_hits;   // Colliding index pairs found by each thread
+    std::vector<std::pair<size_t, size_t>>                  m_pairs;  // Pairs of all threads, merged in index order
+
     /**
      * @brief Checks if an entity collides with another entity.
      * @param position Position component of the first entity.
@@ -44,7 +54,7 @@ private:
     bool CheckCollision(auto& position, auto& collision, ecs::Entity entity);
 
     /**
-     * @brief Dispatches all buffered collision events.
+     * @brief Merges the pairs found by every thread in index order and dispatches them as events.
      */
     void DispatchCollisions();
 };
@@ -20,6 +20,12 @@ EnemySpawnSystem::EnemySpawnSystem(sf::RenderWindow& window, ecs::Coordinator& c
 , m_advancedEnemyInterval(gConfig.GetGameConfig().enemy.advancedEnemy.at("interval"))
 , m_advancedEnemyTimer(0.f)
 {
+    // Enemies are created on the spot, which changes the storage every other system reads
+    m_access.Exclusive();
+
+    // Spawn intervals are over a second long, so a tenth of a second of timer resolution is enough
+    SetUpdateRate(10.f);
+
     m_eventBus.AddListener<SpawnEnemyEvent>(
         [this](const SpawnEnemyEvent &event) {
             OnSpawnEnemy(event);
@@ -47,7 +53,7 @@ void EnemySpawnSystem::Update(const float dt)
 
     m_advancedEnemyTimer -= dt;
 
-    if (m_timer <= 0.f && m_maxEnemyCount > m_entities.Size() && m_playerEntity != ecs::NullEntity)
+    if (m_timer <= 0.f && m_maxEnemyCount > m_entities.Size() && m_coordinator.IsEntityAlive(m_playerEntity))
     {
         EntityFactory::SpawnEnemy(m_window, m_coordinator, m_playerEntity, (m_advancedEnemyTimer <= 0.f));
 
@@ -19,6 +19,9 @@ HealthSystem::HealthSystem(ecs::Coordinator &coordinator, ecs::EventBus &eventBu
 : m_coordinator(coordinator)
 , m_eventBus(eventBus)
 {
+    m_access.Read<HealthChangeComponent, EnemyComponent, AdvancedEnemyComponent, PlayerComponent>()
+            .Write<HealthComponent, ShapeComponent>()
+            .Emit<SpawnEnemyParticlesEvent, PlayerDeadEvent>();
 };
 
 void HealthSystem::Update(float dt)
@@ -26,13 +29,13 @@ void HealthSystem::Update(float dt)
     m_damagedThisFrame.clear();
 
     const auto& eConfig = gConfig.GetGameConfig().enemy;
-    auto m_entitiesCopy = m_entities;
+    auto& commands = m_coordinator.GetCommandBuffer();
 
-    for (auto const& [entity, _] : m_entitiesCopy)
+    for (auto const& [entity, _] : m_entities)
     {
         if(m_damagedThisFrame.contains(entity))
         {
-            m_coordinator.RemoveComponent<HealthChangeComponent>(entity);
+            commands.RemoveComponent<HealthChangeComponent>(entity);
             continue;
         }
 
@@ -41,7 +44,7 @@ void HealthSystem::Update(float dt)
         bool isEnemy = m_coordinator.HasComponent<EnemyComponent>(entity);
         auto& health = m_coordinator.GetComponent<HealthComponent>(entity);
         auto amount = m_coordinator.GetComponent<HealthChangeComponent>(entity).amount;
-        m_coordinator.RemoveComponent<HealthChangeComponent>(entity);
+        commands.RemoveComponent<HealthChangeComponent>(entity);
 
         if(isEnemy)
             m_eventBus.Emit<SpawnEnemyParticlesEvent>({ entity, health.remaining });
@@ -65,6 +68,6 @@ void HealthSystem::Update(float dt)
         if(m_coordinator.HasComponent<PlayerComponent>(entity))
             m_eventBus.Emit<PlayerDeadEvent>({entity});
 
-        m_coordinator.DestroyEntity(entity);
+        commands.DestroyEntity(entity);
     }
 }
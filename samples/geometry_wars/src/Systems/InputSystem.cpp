@@ -8,6 +8,8 @@
 #include <SFML/Window/Mouse.hpp>
 #include "Core/Math/Vec2.hpp"
 
+#include "Components/InputComponent.hpp"
+#include "Components/PlayerComponent.hpp"
 #include "Components/VelocityComponent.hpp"
 #include "Events/FireBulletEvent.hpp"
 #include "Events/SonarAttackEvent.hpp"
@@ -17,6 +19,11 @@ InputSystem::InputSystem(sf::RenderWindow& window, ecs::Coordinator& coordinator
 , m_coordinator(coordinator)
 , m_eventBus(eventBus)
 {
+    // Keyboard and mouse state is read from the window's thread
+    m_access.Read<PlayerComponent, InputComponent>()
+            .Write<VelocityComponent>()
+            .Emit<FireBulletEvent, SonarAttackEvent>()
+            .MainThread();
 }
 
 void InputSystem::Update(float dt)
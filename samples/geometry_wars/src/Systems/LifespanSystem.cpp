@@ -4,6 +4,9 @@
  */
 #include "LifespanSystem.hpp"
 
+#include <cstddef>
+#include <ecs/SimdKernels.hpp>
+
 #include <Components/BulletComponent.hpp>
 #include <Components/CollisionComponent.hpp>
 #include <Components/ParticleComponent.hpp>
@@ -17,28 +20,43 @@
 LifespanSystem::LifespanSystem(ecs::Coordinator& coordinator)
 : m_coordinator(coordinator)
 {
+    m_access.Read<BulletComponent, ParticleComponent, SoundWaveComponent>()
+            .Write<LifespanComponent, ShapeComponent, CollisionComponent>();
 }
 
 void LifespanSystem::Update(float dt)
 {
-    auto m_entitiesCopy = m_entities;
-    for (auto [e, v] : m_entitiesCopy)
+    // Lifespans are stored as columns, so every entity is aged in one vectorized pass
+    auto& lifespans = m_coordinator.GetComponentArray<LifespanComponent>();
+    const std::size_t count = lifespans.Size();
+    const float* total      = lifespans.GetColumn(ecs::SoALane(offsetof(LifespanComponent, total)));
+    float* remaining        = lifespans.GetColumn(ecs::SoALane(offsetof(LifespanComponent, remaining)));
+
+    ecs::Simd::DecrementLifespans(remaining, dt, count);
+
+    // Destruction is recorded for playback, so the columns stay valid for the whole loop
+    const auto& entities = lifespans.GetEntities();
+    auto& commands       = m_coordinator.GetCommandBuffer();
+    for (std::size_t i = 0; i < count; ++i)
     {
-        auto&[total, remaining] = m_coordinator.GetComponent<LifespanComponent>(e);
-        auto& shape = m_coordinator.GetComponent<ShapeComponent>(e);
-        remaining -= dt;
+        const ecs::Entity e = entities[i];
+        if (!m_entities.Contains(e))
+        {
+            continue;
+        }
 
-        if(remaining <= 0.f)
+        if(remaining[i] <= 0.f)
         {
-            m_coordinator.DestroyEntity(e);
+            commands.DestroyEntity(e);
             continue;
         }
 
-        float lifeProgress = (total - remaining) / total;
+        auto& shape = m_coordinator.GetComponent<ShapeComponent>(e);
+        float lifeProgress = (total[i] - remaining[i]) / total[i];
 
         if(m_coordinator.HasComponent<BulletComponent>(e) || m_coordinator.HasComponent<ParticleComponent>(e))
         {
-            auto alpha = static_cast<sf::Uint8>((remaining / total) * 255);
+            auto alpha = static_cast<sf::Uint8>((remaining[i] / total[i]) * 255);
             shape.fillColor.a    = alpha;
             shape.outlineColor.a = alpha;
         }
@@ -55,4 +73,4 @@ void LifespanSystem::Update(float dt)
             shape.vertexShapeData.color.a = alpha;
         }
     }
-}
\ No newline at end of file
+}
@@ -10,17 +10,23 @@
 MovementSystem::MovementSystem(ecs::Coordinator& coordinator)
 : m_coordinator(coordinator)
 {
+    m_access.Read<VelocityComponent>()
+            .Write<TransformComponent>();
 }
 
 void MovementSystem::Update(float dt)
 {
-    for (const auto [e, v] : m_entities)
-    {
-        auto& transform = m_coordinator.GetComponent<TransformComponent>(e);
-        auto& vel       = m_coordinator.GetComponent<VelocityComponent>(e).vec;
+    m_coordinator.Group<TransformComponent, VelocityComponent>().Each(
+        [dt](ecs::Entity, TransformComponent& transform, const VelocityComponent& velocity)
+        {
+            const auto& vel = velocity.vec;
 
-        transform.position.x += vel.x * dt;
-        transform.position.y += vel.y * dt;
-        transform.rotation   += transform.angle * dt;
-    }
+            transform.previousPosition = transform.position;
+            transform.previousRotation = transform.rotation;
+
+            transform.position.x += vel.x * dt;
+            transform.position.y += vel.y * dt;
+            transform.rotation   += transform.angle * dt;
+        }
+    );
 }
@@ -11,6 +11,9 @@ ParticleSystem::ParticleSystem(ecs::Coordinator& coordinator, ecs::EventBus& eve
 : m_coordinator(coordinator)
 , m_eventBus(eventBus)
 {
+    m_access.Write<ShapeComponent>()
+            .Listen<SpawnEnemyParticlesEvent>();
+
     m_eventBus.AddListener<SpawnEnemyParticlesEvent>(
         [this](const SpawnEnemyParticlesEvent &ev) {
             SpawnEnemyParticle(ev);
@@ -31,12 +34,5 @@ void ParticleSystem::SpawnEnemyParticle(const SpawnEnemyParticlesEvent ev)
 {
     auto& [enemy, count] = ev;
 
-    if(count <= 0)
-        return;
-
-    for(int i = 0.f; i < count; ++i)
-    {
-        float angle = 360.f / static_cast<float>(count) * (i + 1);
-        EntityFactory::SpawnParticle(m_coordinator, enemy, angle, count);
-    }
+    EntityFactory::SpawnParticles(m_coordinator, enemy, count, count);
 }
@@ -17,7 +17,12 @@
 RenderSystem::RenderSystem(sf::RenderWindow& window, ecs::Coordinator& coordinator)
 : m_window(window)
 , m_coordinator(coordinator)
+, m_alpha(1.f)
 {
+    // Drawing goes to the window, which belongs to the main thread
+    m_access.Read<TransformComponent, ShapeComponent, SonarWeaponComponent>()
+            .Write<GlowComponent, LightAuraComponent>()
+            .MainThread();
 }
 
 void RenderSystem::Update(const float dt)
@@ -27,6 +32,10 @@ void RenderSystem::Update(const float dt)
         auto& transform = m_coordinator.GetComponent<TransformComponent>(e);
         auto& shapeData = m_coordinator.GetComponent<ShapeComponent>(e);
 
+        // Draw the simulation between its last two steps, matching the time the frame is shown at
+        const Vec2<float> position = transform.previousPosition + (transform.position - transform.previousPosition) * m_alpha;
+        const float rotation = transform.previousRotation + (transform.rotation - transform.previousRotation) * m_alpha;
+
         if (m_coordinator.HasComponent<GlowComponent>(e))
         {
             auto& glowData = m_coordinator.GetComponent<GlowComponent>(e);
@@ -57,8 +66,8 @@ void RenderSystem::Update(const float dt)
             circle.setOutlineThickness(glowData.outlineThickness);
             circle.setOrigin(glowData.originX, glowData.originY);
 
-            circle.setPosition(transform.position.x, transform.position.y);
-            circle.setRotation(transform.rotation);
+            circle.setPosition(position.x, position.y);
+            circle.setRotation(rotation);
 
             m_window.draw(circle);
         }
@@ -79,7 +88,7 @@ void RenderSystem::Update(const float dt)
                 auraComp.timer  = auraComp.interval;
             }
 
-            sf::VertexArray aura = CreateVertexCircleGradient(transform.position.x, transform.position.y,
+            sf::VertexArray aura = CreateVertexCircleGradient(position.x, position.y,
                 auraComp.radius, auraComp.color, auraComp.segments, auraComp.color.a, 0, 8.f);
             m_window.draw(aura);
         }
@@ -92,8 +101,8 @@ void RenderSystem::Update(const float dt)
             circle.setOutlineThickness(shapeData.outlineThickness);
             circle.setOrigin(shapeData.originX, shapeData.originY);
 
-            circle.setPosition(transform.position.x, transform.position.y);
-            circle.setRotation(transform.rotation);
+            circle.setPosition(position.x, position.y);
+            circle.setRotation(rotation);
 
             m_window.draw(circle);
         }
@@ -101,7 +110,7 @@ void RenderSystem::Update(const float dt)
         if (shapeData.shapeType == ShapeType::Vertex)
         {
             auto& [ segments, color, radius ] = shapeData.vertexShapeData;
-            sf::VertexArray soundWave = CreateVertexCircleGradient(transform.position.x, transform.position.y,
+            sf::VertexArray soundWave = CreateVertexCircleGradient(position.x, position.y,
                 radius, color, segments, 0, color.a, 12.f);
             m_window.draw(soundWave);
         }
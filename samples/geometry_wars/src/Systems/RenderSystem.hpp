@@ -28,9 +28,16 @@ public:
      */
     void Update(float dt) override;
 
+    /**
+     * @brief Sets how far rendering is between the previous and the last simulation step.
+     * @param alpha Interpolation alpha in [0, 1), see ecs::PhaseScheduler::GetAlpha.
+     */
+    void SetAlpha(float alpha) { m_alpha = alpha; }
+
 private:
     sf::RenderWindow& m_window;     // Reference to the SFML render window
     ecs::Coordinator& m_coordinator;  // Reference to the ECS coordinator
+    float             m_alpha;        // Blend between previous and current transforms
 
     /**
      * @brief Creates a circular gradient using a vertex array.
@@ -13,6 +13,10 @@ WeaponSystem::WeaponSystem(ecs::Coordinator& coordinator, ecs::EventBus& eventBu
 : m_coordinator(coordinator)
 , m_eventBus(eventBus)
 {
+    m_access.Read<WeaponComponent>()
+            .Write<GunComponent, SonarWeaponComponent>()
+            .Listen<FireBulletEvent, SonarAttackEvent>();
+
     m_eventBus.AddListener<FireBulletEvent>(
         [this](const FireBulletEvent& event) {
             OnFireBullet(event);
@@ -0,0 +1,248 @@
+/**
+ * @file EventBusStressTest.cpp
+ * @brief Emits events from every JobSystem thread and checks what ProcessEvents delivers.
+ *
+ * Takes the worker count as its first argument. Checks that no event is lost, that
+ * batch listeners see the same events, that events queued from ParallelFor chunks
+ * and Scheduler systems arrive in single-threaded order whichever thread queued
+ * them, that fast events reach their listeners right away, and that parallel
+ * dispatch keeps the order within a type.
+ * Returns a nonzero exit code on the first failed check, also in release builds.
+ */
+#include <ecs/EventBus.hpp>
+#include <ecs/JobSystem.hpp>
+#include <ecs/Scheduler.hpp>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    constexpr int FrameCount = 50;
+    constexpr std::size_t EventsPerFrame = 20000;
+    constexpr std::size_t FastEventInterval = 100;
+    constexpr std::size_t Grain = 64;
+
+    struct SequencedEventA
+    {
+        std::size_t source;
+        std::size_t sequence;
+    };
+
+    struct SequencedEventB
+    {
+        std::size_t source;
+        std::size_t sequence;
+    };
+
+    struct FastEvent
+    {
+        int value;
+    };
+
+    bool Check(const bool condition, const char* what)
+    {
+        if (!condition)
+        {
+            std::fprintf(stderr, "EventBusStressTest failed: %s\n", what);
+        }
+        return condition;
+    }
+
+    bool TestWorkerEmits(ecs::JobSystem& jobs, ecs::EventBus& bus)
+    {
+        std::vector<std::pair<std::size_t, std::size_t>> order;
+        std::size_t countA = 0;
+        std::size_t countB = 0;
+        std::size_t countBatch = 0;
+        std::atomic<std::size_t> countFast {0};
+
+        order.reserve(EventsPerFrame);
+        bus.AddListener<SequencedEventA>([&](const SequencedEventA& event)
+        {
+            order.emplace_back(event.source, event.sequence);
+            ++countA;
+        });
+        bus.AddListener<SequencedEventB>([&](const SequencedEventB& event)
+        {
+            order.emplace_back(event.source, event.sequence);
+            ++countB;
+        });
+        bus.AddBatchListener<SequencedEventB>([&](const std::span<const SequencedEventB> events)
+        {
+            countBatch += events.size();
+        });
+        bus.AddListener<FastEvent>([&](const FastEvent&)
+        {
+            countFast.fetch_add(1, std::memory_order_relaxed);
+        });
+
+        for (int frame = 0; frame < FrameCount; ++frame)
+        {
+            jobs.ParallelFor(0, EventsPerFrame, Grain, [&](const std::size_t begin, const std::size_t end)
+            {
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    if (i % 3 == 0)
+                    {
+                        bus.Emit(SequencedEventB {0, i});
+                    }
+                    else
+                    {
+                        bus.Emit(SequencedEventA {0, i});
+                    }
+                    if (i % FastEventInterval == 0)
+                    {
+                        bus.Emit(FastEvent {1}, true);
+                    }
+                }
+            });
+
+            order.clear();
+            countA = 0;
+            countB = 0;
+            countBatch = 0;
+            bus.ProcessEvents();
+
+            if (!Check(countA + countB == EventsPerFrame, "an emitted event was not delivered")
+                || !Check(countBatch == countB, "the batch listener missed events"))
+            {
+                return false;
+            }
+
+            // Chunks are merged in range order, whichever thread ran them
+            for (std::size_t i = 0; i < order.size(); ++i)
+            {
+                if (!Check(order[i].second == i, "events of ParallelFor chunks are not in range order"))
+                {
+                    return false;
+                }
+            }
+        }
+
+        return Check(countFast.load() == FrameCount * EventsPerFrame / FastEventInterval,
+                     "a fast event did not reach its listener");
+    }
+
+    bool TestSchedulerOrder(ecs::JobSystem& jobs, ecs::EventBus& bus)
+    {
+        constexpr std::size_t SystemCount = 8;
+        constexpr std::size_t EventsPerSystem = 4096;
+
+        std::vector<std::pair<std::size_t, std::size_t>> order;
+        bus.UnsubscribeAll();
+        bus.AddListener<SequencedEventA>([&](const SequencedEventA& event)
+        {
+            order.emplace_back(event.source, event.sequence);
+        });
+
+        // The systems do not conflict, so they run in parallel on whichever threads are free
+        ecs::Scheduler scheduler(jobs);
+        for (std::size_t system = 1; system <= SystemCount; ++system)
+        {
+            scheduler.Add("Emitter", [&jobs, &bus, system](float)
+            {
+                bus.Emit(SequencedEventA {system, 0});
+                jobs.ParallelFor(1, EventsPerSystem - 1, Grain, [&bus, system](const std::size_t begin, const std::size_t end)
+                {
+                    for (std::size_t i = begin; i < end; ++i)
+                    {
+                        bus.Emit(SequencedEventA {system, i});
+                    }
+                });
+                bus.Emit(SequencedEventA {system, EventsPerSystem - 1});
+            }, ecs::SystemAccess().Emit<SequencedEventA>());
+        }
+
+        for (int frame = 0; frame < FrameCount; ++frame)
+        {
+            order.clear();
+            bus.Emit(SequencedEventA {0, 0});
+            scheduler.Update(0.f);
+            bus.Emit(SequencedEventA {SystemCount + 1, 0});
+            bus.ProcessEvents();
+
+            // Queued before the update, then each system in the order it was added, then queued after the update
+            if (!Check(order.size() == SystemCount * EventsPerSystem + 2, "an event queued by a system was lost")
+                || !Check(order.front().first == 0 && order.back().first == SystemCount + 1,
+                          "events queued around the update are out of order"))
+            {
+                return false;
+            }
+            for (std::size_t i = 1; i + 1 < order.size(); ++i)
+            {
+                const std::size_t system = (i - 1) / EventsPerSystem + 1;
+                const std::size_t sequence = (i - 1) % EventsPerSystem;
+                if (!Check(order[i].first == system && order[i].second == sequence,
+                           "events of parallel systems are not in the order the systems were added"))
+                {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    bool TestParallelDispatch(ecs::EventBus& bus)
+    {
+        constexpr std::size_t EventCount = 10000;
+
+        std::atomic<std::size_t> countA {0};
+        std::atomic<std::size_t> countB {0};
+        std::size_t lastSequence = 0;
+        bool ordered = true;
+
+        bus.UnsubscribeAll();
+        bus.AddListener<SequencedEventA>([&](const SequencedEventA& event)
+        {
+            ordered = ordered && event.sequence >= lastSequence;
+            lastSequence = event.sequence;
+            countA.fetch_add(1, std::memory_order_relaxed);
+        });
+        bus.AddListener<SequencedEventB>([&](const SequencedEventB&)
+        {
+            countB.fetch_add(1, std::memory_order_relaxed);
+        });
+
+        bus.SetParallelDispatch(true);
+        for (std::size_t i = 0; i < EventCount; ++i)
+        {
+            if (i % 2 == 0)
+            {
+                bus.Emit(SequencedEventB {0, i});
+            }
+            else
+            {
+                bus.Emit(SequencedEventA {0, i});
+            }
+        }
+        bus.ProcessEvents();
+        bus.SetParallelDispatch(false);
+
+        return Check(countA.load() == EventCount / 2 && countB.load() == EventCount / 2,
+                     "parallel dispatch lost events")
+            && Check(ordered, "parallel dispatch reordered events of one type");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t workers = argc > 1 ? static_cast<std::size_t>(std::atoi(argv[1])) : 7;
+
+    ecs::JobSystem jobs(workers);
+    ecs::EventBus bus;
+    bus.SetJobSystem(jobs);
+
+    if (!TestWorkerEmits(jobs, bus) || !TestSchedulerOrder(jobs, bus) || !TestParallelDispatch(bus))
+    {
+        return EXIT_FAILURE;
+    }
+
+    std::printf("EventBusStressTest passed with %zu workers\n", workers);
+    return EXIT_SUCCESS;
+}